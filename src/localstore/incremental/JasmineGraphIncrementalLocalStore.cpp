@@ -78,7 +78,7 @@ std::string JasmineGraphIncrementalLocalStore::addGraphEdgeFromString(std::strin
             char valueDes[PropertyLink::MAX_VALUE_SIZE] = {};
 
 //                    store source nodeBlock
-            if (nm->nodeIndex.find(sId) == nm->nodeIndex.end()) {
+            if (!nm->nodeIndex.contains(sId)) {
                 NodeBlock *sourceBlock = this->nm->addNode(sId);
                 if (sourceJson.contains("properties")) {
                     auto sourceProps = sourceJson["properties"];
@@ -90,7 +90,7 @@ std::string JasmineGraphIncrementalLocalStore::addGraphEdgeFromString(std::strin
 
             }
         //        store destination nodeBlock
-            if (nm->nodeIndex.find(dId) == nm->nodeIndex.end()) {
+            if (!nm->nodeIndex.contains(dId)) {
                 NodeBlock *destinationBlock = this->nm->addNode(dId);
                 if (destinationJson.contains("properties")) {
                     auto destinationProps = destinationJson["properties"];
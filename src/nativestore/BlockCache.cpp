@@ -0,0 +1,150 @@
+/**
+Copyright 2023 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+**/
+
+#include "BlockCache.h"
+
+#include <cstring>
+
+BlockCache::BlockCache(MmapBlockFile *file, unsigned long blockSize, unsigned long budgetBytes)
+    : file(file), blockSize(blockSize) {
+    this->setCount = budgetBytes / (blockSize * WAYS + sizeof(Set));
+    if (this->setCount == 0) {
+        return;
+    }
+    this->sets.reset(new Set[this->setCount]);
+    this->slab.reset(new char[this->setCount * WAYS * blockSize]);  // Left untouched until blocks are cached in it
+    for (unsigned long i = 0; i < this->setCount; i++) {
+        Set &set = this->sets[i];
+        set.sequence.store(0, std::memory_order_relaxed);
+        set.referenced.store(0, std::memory_order_relaxed);
+        set.hand = 0;
+        for (unsigned int way = 0; way < WAYS; way++) {
+            set.tags[way].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+int BlockCache::findWay(Set &set, unsigned int tag) {
+    for (unsigned int way = 0; way < WAYS; way++) {
+        if (set.tags[way].load(std::memory_order_relaxed) == tag) {
+            return way;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Copy one whole block at the given address into block, loading it from the file on a miss
+ * */
+bool BlockCache::read(unsigned long address, void *block) {
+    if (this->setCount == 0) {
+        return this->file->read(address, block, blockSize);
+    }
+    unsigned int tag = address / blockSize + 1;
+    unsigned long setIndex = this->setOf(tag);
+    Set &set = this->sets[setIndex];
+    unsigned int sequence = set.sequence.load(std::memory_order_acquire);
+    if ((sequence & 1) == 0) {
+        int way = this->findWay(set, tag);
+        if (way >= 0) {
+            std::memcpy(block, this->slotData(setIndex, way), blockSize);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (set.sequence.load(std::memory_order_relaxed) == sequence) {
+                unsigned char bit = 1 << way;
+                if (!(set.referenced.load(std::memory_order_relaxed) & bit)) {
+                    set.referenced.fetch_or(bit, std::memory_order_relaxed);
+                }
+                this->count(this->shards[setIndex % SHARD_COUNT].hits);
+                return true;
+            }
+        }
+    }
+    return this->readLocked(setIndex, tag, address, block);
+}
+
+/**
+ * Slow path of read(): look the block up again with the shard locked and load it into its set on a miss
+ * */
+bool BlockCache::readLocked(unsigned long setIndex, unsigned int tag, unsigned long address, void *block) {
+    Shard &shard = this->shards[setIndex % SHARD_COUNT];
+    Set &set = this->sets[setIndex];
+    std::lock_guard<std::mutex> guard(shard.lock);
+    int way = this->findWay(set, tag);
+    if (way >= 0) {  // Filled by another thread, or the lock free copy raced with a patch
+        std::memcpy(block, this->slotData(setIndex, way), blockSize);
+        set.referenced.fetch_or(1 << way, std::memory_order_relaxed);
+        this->count(shard.hits);
+        return true;
+    }
+
+    this->count(shard.misses);
+    if (!this->file->read(address, block, blockSize)) {
+        return false;
+    }
+    // Advance the CLOCK hand past recently referenced ways, clearing their bits, and evict the first other way
+    while (set.tags[set.hand].load(std::memory_order_relaxed) != 0 &&
+           (set.referenced.load(std::memory_order_relaxed) & (1 << set.hand))) {
+        set.referenced.fetch_and(~(1 << set.hand), std::memory_order_relaxed);
+        set.hand = (set.hand + 1) % WAYS;
+    }
+    way = set.hand;
+    set.hand = (set.hand + 1) % WAYS;
+
+    set.sequence.fetch_add(1, std::memory_order_relaxed);  // Odd, lock free readers of this set retry here
+    std::atomic_thread_fence(std::memory_order_release);
+    set.tags[way].store(tag, std::memory_order_relaxed);
+    std::memcpy(this->slotData(setIndex, way), block, blockSize);
+    set.sequence.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * Write size bytes at offset within the block at the given address to the file, and patch the cached copy if the
+ * block is cached. Blocks are not loaded into the cache on write
+ * */
+bool BlockCache::write(unsigned long address, unsigned long offset, const void *data, unsigned long size) {
+    if (this->setCount == 0) {
+        return this->file->write(address + offset, data, size);
+    }
+    unsigned int tag = address / blockSize + 1;
+    unsigned long setIndex = this->setOf(tag);
+    Set &set = this->sets[setIndex];
+    std::lock_guard<std::mutex> guard(this->shards[setIndex % SHARD_COUNT].lock);
+    if (!this->file->write(address + offset, data, size)) {
+        return false;
+    }
+    int way = this->findWay(set, tag);
+    if (way >= 0) {
+        set.sequence.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(this->slotData(setIndex, way) + offset, data, size);
+        set.sequence.fetch_add(1, std::memory_order_release);
+    }
+    return true;
+}
+
+unsigned long BlockCache::getHits() {
+    unsigned long total = 0;
+    for (unsigned int i = 0; i < SHARD_COUNT; i++) {
+        total += this->shards[i].hits.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+unsigned long BlockCache::getMisses() {
+    unsigned long total = 0;
+    for (unsigned int i = 0; i < SHARD_COUNT; i++) {
+        total += this->shards[i].misses.load(std::memory_order_relaxed);
+    }
+    return total;
+}
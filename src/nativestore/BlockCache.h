@@ -0,0 +1,85 @@
+/**
+Copyright 2023 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+**/
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include "MmapBlockFile.h"
+
+#ifndef BLOCK_CACHE
+#define BLOCK_CACHE
+
+/**
+ * Sized, sharded LRU cache of fixed size blocks in front of a MmapBlockFile.
+ *
+ * The cache is set associative: a block can only live in the WAYS slots of the set its address maps to. On a miss
+ * the set evicts with the CLOCK approximation of LRU (a slot used since the hand last passed it gets a second
+ * chance). Sets are spread over SHARD_COUNT locks which are only taken to fill or patch a slot.
+ *
+ * Hits do not lock. Each set has a sequence number that is odd while the set is being changed, and a reader
+ * retries under the shard lock if the number moved while it copied the block out.
+ *
+ * All reads and writes of a block file go through its cache. Writes are written through to the file and patch the
+ * cached copy in place, so the cache never holds a block that differs from the file.
+ * A cache created with a zero budget keeps nothing and passes every call straight to the file.
+ **/
+class BlockCache {
+   private:
+    static const unsigned int WAYS = 8;
+    static const unsigned int SHARD_COUNT = 64;
+
+    struct Shard {
+        std::mutex lock;
+        std::atomic<unsigned long> hits{0};
+        std::atomic<unsigned long> misses{0};
+    };
+
+    // Everything a lookup touches besides the block bytes, kept within one cache line
+    struct Set {
+        std::atomic<unsigned int> sequence;     // Odd while the set is being changed
+        std::atomic<unsigned char> referenced;  // CLOCK reference bit of each way
+        unsigned char hand;                     // CLOCK hand
+        std::atomic<unsigned int> tags[WAYS];   // Block index + 1 held by each way, 0 if empty
+    };
+
+    MmapBlockFile *file;
+    unsigned long blockSize;
+    unsigned long setCount = 0;
+    std::unique_ptr<Set[]> sets;
+    std::unique_ptr<char[]> slab;  // Block bytes of each slot, WAYS consecutive slots per set
+    Shard shards[SHARD_COUNT];
+
+    // WAYS consecutive blocks share a set, so a cache larger than the file packs its blocks densely in the slab
+    unsigned long setOf(unsigned int tag) { return ((tag - 1) / WAYS) % setCount; };
+    char *slotData(unsigned long set, int way) { return &slab[(set * WAYS + way) * blockSize]; };
+    // Statistics only. A plain load and store avoids a locked instruction per hit, at the cost of a lost count
+    // now and then when two threads hit the same shard at once
+    void count(std::atomic<unsigned long> &counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    };
+    int findWay(Set &set, unsigned int tag);
+    bool readLocked(unsigned long set, unsigned int tag, unsigned long address, void *block);
+
+   public:
+    BlockCache(MmapBlockFile *file, unsigned long blockSize, unsigned long budgetBytes);
+
+    bool read(unsigned long address, void *block);
+    bool write(unsigned long address, unsigned long offset, const void *data, unsigned long size);
+
+    unsigned long getHits();
+    unsigned long getMisses();
+    unsigned long getCapacity() { return setCount * WAYS; };
+};
+
+#endif
@@ -0,0 +1,69 @@
+/**
+Copyright 2023 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+**/
+
+#ifndef BLOCK_RECORDS
+#define BLOCK_RECORDS
+
+/**
+ * On-disk layouts of the native store blocks.
+ *
+ * Each struct is the exact byte image of one block in its database file, so a block is persisted with a single
+ * write and loaded with a single read. Field order must not change without bumping STORE_FORMAT_VERSION.
+ **/
+
+const unsigned short STORE_FORMAT_VERSION = 1;
+
+#pragma pack(push, 1)
+
+// Node block in <graph>_<partition>_nodes.db
+struct NodeRecord {
+    char usage;                   // Whether this block is in use or not
+    unsigned int nodeId;          // Vertex ID
+    unsigned int edgeRef;         // Head of the local relation list
+    unsigned int centralEdgeRef;  // Head of the central (edge cut) relation list
+    unsigned char edgeRefPID;     // Partition ID of the edge reference
+    unsigned int propRef;         // Head of the property list
+    char label[6];
+};
+
+// Relation block in <graph>_<partition>_relations.db and _central_relations.db, see RelationOffsets
+struct RelationRecord {
+    unsigned int sourceId;
+    unsigned int destinationId;
+    unsigned int sourceAddress;
+    unsigned int destinationAddress;
+    unsigned int sourceNext;
+    unsigned int sourceNextPid;
+    unsigned int sourcePrevious;
+    unsigned int sourcePreviousPid;
+    unsigned int destinationNext;
+    unsigned int destinationNextPid;
+    unsigned int destinationPrevious;
+    unsigned int destinationPreviousPid;
+    unsigned int propertyAddress;
+};
+
+// Property block in <graph>_<partition>_properties.db and _edge_properties.db
+struct PropertyRecord {
+    char name[12];
+    char value[180];
+    unsigned int next;
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(NodeRecord) == 24, "Node record must match NodeBlock::BLOCK_SIZE");
+static_assert(sizeof(RelationRecord) == 52, "Relation record must match RelationBlock::BLOCK_SIZE");
+static_assert(sizeof(PropertyRecord) == 196, "Property record must match PROPERTY_BLOCK_SIZE");
+
+#endif
@@ -0,0 +1,174 @@
+/**
+Copyright 2023 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+**/
+
+#include "MmapBlockFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include "../util/logger/Logger.h"
+
+Logger mmap_block_file_logger;
+
+MmapBlockFile::MmapBlockFile(std::string path, bool truncate) : path(path) {
+    pthread_rwlock_init(&mapLock, NULL);
+    int flags = O_RDWR | O_CREAT;
+    if (truncate) {
+        flags |= O_TRUNC;
+    }
+    this->fd = ::open(path.c_str(), flags, 0644);
+    if (this->fd < 0) {
+        std::string errorMessage = "Error while opening the block file " + path + " : " + std::strerror(errno);
+        mmap_block_file_logger.error(errorMessage);
+        throw std::runtime_error(errorMessage);
+    }
+
+    struct stat result;
+    if (fstat(this->fd, &result) != 0) {
+        std::string errorMessage = "Error while reading file stats in " + path;
+        mmap_block_file_logger.error(errorMessage);
+        throw std::runtime_error(errorMessage);
+    }
+    this->length = result.st_size;
+    if (result.st_size > 0 && !this->map(result.st_size)) {
+        throw std::runtime_error("Error while mapping the block file " + path);
+    }
+}
+
+MmapBlockFile::~MmapBlockFile() {
+    this->close();
+    pthread_rwlock_destroy(&mapLock);
+}
+
+/**
+ * (Re)map the file so that at least minCapacity bytes are addressable. The file is extended to the new capacity
+ * first because touching a mapped page beyond the end of the file raises SIGBUS.
+ * Caller must hold the write lock (or be the constructor).
+ **/
+bool MmapBlockFile::map(unsigned long minCapacity) {
+    unsigned long newCapacity = ((minCapacity + CHUNK_SIZE - 1) / CHUNK_SIZE) * CHUNK_SIZE;
+    if (ftruncate(this->fd, newCapacity) != 0) {
+        mmap_block_file_logger.error("Error while extending the block file " + this->path + " to " +
+                                     std::to_string(newCapacity) + " bytes");
+        return false;
+    }
+    if (this->base) {
+        munmap(this->base, this->capacity);
+        this->base = NULL;
+        this->capacity = 0;
+    }
+    void *mapped = mmap(NULL, newCapacity, PROT_READ | PROT_WRITE, MAP_SHARED, this->fd, 0);
+    if (mapped == MAP_FAILED) {
+        mmap_block_file_logger.error("Error while mapping the block file " + this->path + " : " +
+                                     std::strerror(errno));
+        return false;
+    }
+    this->base = static_cast<char *>(mapped);
+    this->capacity = newCapacity;
+    return true;
+}
+
+bool MmapBlockFile::ensureCapacity(unsigned long requiredSize) {
+    pthread_rwlock_wrlock(&mapLock);
+    bool mapped = true;
+    if (requiredSize > this->capacity) {  // Another writer might have grown the mapping already
+        mapped = this->map(requiredSize);
+    }
+    pthread_rwlock_unlock(&mapLock);
+    return mapped;
+}
+
+bool MmapBlockFile::read(unsigned long offset, void *data, unsigned long size) {
+    if (this->fd < 0 || offset + size > this->length.load()) {
+        return false;
+    }
+    pthread_rwlock_rdlock(&mapLock);
+    std::memcpy(data, this->base + offset, size);
+    pthread_rwlock_unlock(&mapLock);
+    return true;
+}
+
+bool MmapBlockFile::write(unsigned long offset, const void *data, unsigned long size) {
+    if (this->fd < 0) {
+        return false;
+    }
+    unsigned long end = offset + size;
+    pthread_rwlock_rdlock(&mapLock);
+    while (end > this->capacity) {
+        pthread_rwlock_unlock(&mapLock);
+        if (!this->ensureCapacity(end)) {
+            return false;
+        }
+        pthread_rwlock_rdlock(&mapLock);
+    }
+    std::memcpy(this->base + offset, data, size);
+    pthread_rwlock_unlock(&mapLock);
+
+    unsigned long currentLength = this->length.load();
+    while (end > currentLength && !this->length.compare_exchange_weak(currentLength, end)) {
+    }
+    return true;
+}
+
+/**
+ * Drop everything after newLength from the logical file. Used to cut off a partly written tail found after an
+ * unclean shutdown, when the file still has the size of its last mapping
+ **/
+void MmapBlockFile::trim(unsigned long newLength) {
+    if (newLength < this->length.load()) {
+        this->length = newLength;
+    }
+}
+
+/**
+ * Flush dirty pages of the mapping to disk. Used on checkpoints (ie: NodeManager::close)
+ **/
+bool MmapBlockFile::sync() {
+    pthread_rwlock_rdlock(&mapLock);
+    bool synced = true;
+    if (this->base && msync(this->base, this->capacity, MS_SYNC) != 0) {
+        mmap_block_file_logger.error("Error while syncing the block file " + this->path);
+        synced = false;
+    }
+    pthread_rwlock_unlock(&mapLock);
+    return synced;
+}
+
+/**
+ * Sync, unmap and trim the file back to its logical length so that the block size checks done when reopening the
+ * file still hold.
+ **/
+void MmapBlockFile::close() {
+    if (this->fd < 0) {
+        return;
+    }
+    this->sync();
+    pthread_rwlock_wrlock(&mapLock);
+    if (this->base) {
+        munmap(this->base, this->capacity);
+        this->base = NULL;
+        this->capacity = 0;
+    }
+    if (ftruncate(this->fd, this->length.load()) != 0) {
+        mmap_block_file_logger.error("Error while trimming the block file " + this->path);
+    }
+    ::close(this->fd);
+    this->fd = -1;
+    pthread_rwlock_unlock(&mapLock);
+}
@@ -0,0 +1,61 @@
+/**
+Copyright 2023 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+**/
+
+#include <pthread.h>
+
+#include <atomic>
+#include <string>
+
+#ifndef MMAP_BLOCK_FILE
+#define MMAP_BLOCK_FILE
+
+/**
+ * Memory mapped, block addressed database file used by the native store.
+ *
+ * Reads and writes are plain memory copies into the mapped region instead of seek + read/write calls on an
+ * std::fstream. The mapping grows in CHUNK_SIZE steps as data is written past the current end, and the file is
+ * trimmed back to its logical length when it is closed.
+ *
+ * Reads and writes of different blocks may run concurrently. Growing the mapping takes an exclusive lock so
+ * no reader or writer ever sees a stale base address.
+ **/
+class MmapBlockFile {
+   private:
+    int fd = -1;
+    char *base = NULL;                     // Start of the mapped region
+    unsigned long capacity = 0;            // Number of mapped bytes, always a multiple of CHUNK_SIZE
+    std::atomic<unsigned long> length{0};  // Logical size of the file (end of the last written byte)
+    std::string path;
+    pthread_rwlock_t mapLock;
+
+    bool ensureCapacity(unsigned long);
+    bool map(unsigned long);
+
+   public:
+    static const unsigned long CHUNK_SIZE = 4 * 1024 * 1024;  // Growth step of the mapping in bytes
+
+    MmapBlockFile(std::string path, bool truncate);
+    ~MmapBlockFile();
+
+    bool isOpen() { return fd >= 0; };
+    unsigned long size() { return length.load(); };
+    std::string getPath() { return path; };
+
+    bool read(unsigned long offset, void *data, unsigned long size);
+    bool write(unsigned long offset, const void *data, unsigned long size);
+    void trim(unsigned long newLength);
+    bool sync();
+    void close();
+};
+
+#endif
@@ -20,13 +20,12 @@ limitations under the License.
 #include "RelationBlock.h"
 
 Logger node_block_logger;
-pthread_mutex_t lockSaveNode;
-pthread_mutex_t lockAddNodeProperty;
 
 
-NodeBlock::NodeBlock(std::string id, unsigned int nodeId, unsigned int address, unsigned int propRef, unsigned int edgeRef,unsigned int centralEdgeRef,
-                     unsigned char edgeRefPID, char _label[], bool usage)
-    : id(id),nodeId(nodeId), addr(address), propRef(propRef), edgeRef(edgeRef),centralEdgeRef(centralEdgeRef), edgeRefPID(edgeRefPID), usage(usage) {
+NodeBlock::NodeBlock(StoreHandles* store, std::string id, unsigned int nodeId, unsigned int address,
+                     unsigned int propRef, unsigned int edgeRef, unsigned int centralEdgeRef, unsigned char edgeRefPID,
+                     char _label[], bool usage)
+    : store(store), id(id),nodeId(nodeId), addr(address), propRef(propRef), edgeRef(edgeRef),centralEdgeRef(centralEdgeRef), edgeRefPID(edgeRefPID), usage(usage) {
     strcpy(label, _label);
 };
 
@@ -43,15 +42,17 @@ void NodeBlock::save() {
 //    if (isSmallLabel) {
 //        std::strcpy(this->label, this->id.c_str());
 //    }
-    NodeBlock::nodesDB->seekp(this->addr);
-    NodeBlock::nodesDB->put(this->usage); // 1
-    NodeBlock::nodesDB->write(reinterpret_cast<char*>(&(this->nodeId)), sizeof(this->nodeId)); // 4
-    NodeBlock::nodesDB->write(reinterpret_cast<char*>(&(this->edgeRef)), sizeof(this->edgeRef)); // 4
-    NodeBlock::nodesDB->write(reinterpret_cast<char*>(&(this->centralEdgeRef)), sizeof(this->centralEdgeRef)); // 4
-    NodeBlock::nodesDB->put(this->edgeRefPID); // 1
-    NodeBlock::nodesDB->write(reinterpret_cast<char*>(&(this->propRef)), sizeof(this->propRef)); // 4
-    NodeBlock::nodesDB->write(this->label, sizeof(this->label)); // 6
-    NodeBlock::nodesDB->flush();  // Sync the file with in-memory stream
+    NodeRecord record;
+    record.usage = this->usage;
+    record.nodeId = this->nodeId;
+    record.edgeRef = this->edgeRef;
+    record.centralEdgeRef = this->centralEdgeRef;
+    record.edgeRefPID = this->edgeRefPID;
+    record.propRef = this->propRef;
+    std::memcpy(record.label, this->label, sizeof(record.label));
+    if (!this->store->nodesCache->write(this->addr, 0, &record, sizeof(record))) {
+        node_block_logger.error("Error while saving node block " + std::to_string(this->addr));
+    }
 //    pthread_mutex_unlock(&lockSaveNode);
 
 //    if (!isSmallLabel) {
@@ -62,16 +63,15 @@ void NodeBlock::save() {
 void NodeBlock::addProperty(std::string name, char* value) {
 
     if (this->propRef == 0) {
-        PropertyLink* newLink = PropertyLink::create(name, value);
+        PropertyLink* newLink = PropertyLink::create(this->store, name, value);
 //        pthread_mutex_lock(&lockAddNodeProperty);
         if (newLink) {
             this->propRef = newLink->blockAddress;
             // If it was an empty prop link before inserting, Then update the property reference of this node
             // block
 //            node_block_logger.info("propRef = " + std::to_string(this->propRef));
-            NodeBlock::nodesDB->seekp(this->addr + sizeof(this->nodeId) + sizeof(this->edgeRef) + sizeof(this->centralEdgeRef) + sizeof(this->edgeRefPID));
-            NodeBlock::nodesDB->write(reinterpret_cast<char*>(&(this->propRef)), sizeof(this->propRef));
-            NodeBlock::nodesDB->flush();
+            this->store->nodesCache->write(this->addr, offsetof(NodeRecord, propRef), &(this->propRef),
+                                           sizeof(this->propRef));
         } else {
             throw "Error occurred while adding a new property link to " + std::to_string(this->addr) + " node block";
         }
@@ -183,7 +183,7 @@ bool NodeBlock::updateCentralRelation(RelationBlock* newRelation, bool relocateH
 RelationBlock* NodeBlock::getRelationHead() {
     RelationBlock* relationsHead = NULL;
     if (this->edgeRef != 0) {
-        relationsHead = RelationBlock::get(this->edgeRef);
+        relationsHead = RelationBlock::get(this->store, this->edgeRef);
     }
     return relationsHead;
 };
@@ -191,39 +191,51 @@ RelationBlock* NodeBlock::getRelationHead() {
 RelationBlock* NodeBlock::getCentralRelationHead() {
     RelationBlock* relationsHead = NULL;
     if (this->centralEdgeRef != 0) {
-        relationsHead = RelationBlock::getCentral(this->centralEdgeRef);
+        relationsHead = RelationBlock::getCentral(this->store, this->centralEdgeRef);
     }
     return relationsHead;
 };
 
 bool NodeBlock::setRelationHead(RelationBlock newRelation) {
     unsigned int edgeReferenceAddress = newRelation.addr;
-    int edgeReferenceOffset = sizeof(this->usage) + sizeof(this->nodeId);
-    NodeBlock::nodesDB->seekp(this->addr + edgeReferenceOffset);
-    if (!NodeBlock::nodesDB->write(reinterpret_cast<char*>(&(edgeReferenceAddress)), sizeof(unsigned int))) {
+    if (!this->store->nodesCache->write(this->addr, offsetof(NodeRecord, edgeRef), &(edgeReferenceAddress),
+                                        sizeof(unsigned int))) {
         node_block_logger.error("ERROR: Error while updating edge reference address of " +
                                 std::to_string(edgeReferenceAddress) + " for node " + std::to_string(this->addr));
         return false;
     }
-    NodeBlock::nodesDB->flush();  // Sync the file with in-memory stream
     this->edgeRef = edgeReferenceAddress;
     return true;
 }
 
 bool NodeBlock::setCentralRelationHead(RelationBlock newRelation) {
     unsigned int centralEdgeReferenceAddress = newRelation.addr;
-    int edgeReferenceOffset = sizeof(this->usage) + sizeof(this->nodeId);
-    NodeBlock::nodesDB->seekp(this->addr + edgeReferenceOffset + sizeof(this->edgeRef));
-    if (!NodeBlock::nodesDB->write(reinterpret_cast<char*>(&(centralEdgeReferenceAddress)), sizeof(unsigned int))) {
+    if (!this->store->nodesCache->write(this->addr, offsetof(NodeRecord, centralEdgeRef),
+                                        &(centralEdgeReferenceAddress), sizeof(unsigned int))) {
         node_block_logger.error("ERROR: Error while updating edge reference address of " +
                                 std::to_string(centralEdgeReferenceAddress) + " for node " + std::to_string(this->addr));
         return false;
     }
-    NodeBlock::nodesDB->flush();  // Sync the file with in-memory stream
     this->centralEdgeRef = centralEdgeReferenceAddress;
     return true;
 }
 
+/**
+ * Re-read the relation list heads from the nodes DB. A NodeBlock is a snapshot taken when it was read, so
+ * another ingest thread may have relocated the heads since then. Must be called with the node lock held before
+ * splicing in a new relation
+ * **/
+bool NodeBlock::reloadRelationHeads() {
+    NodeRecord record;
+    if (!this->store->nodesCache->read(this->addr, &record)) {
+        node_block_logger.error("Error while reloading relation heads of node block " + std::to_string(this->addr));
+        return false;
+    }
+    this->edgeRef = record.edgeRef;
+    this->centralEdgeRef = record.centralEdgeRef;
+    return true;
+}
+
 /**
  * Return a pointer to matching relation block with the given node if found, Else return NULL
  * **/
@@ -288,10 +300,10 @@ std::list<NodeBlock> NodeBlock::getEdges() {
     while (currentRelation != NULL) {
         NodeBlock* node = NULL;
         if (currentRelation->source.address == this->addr) {
-            node = NodeBlock::get(currentRelation->destination.address);
+            node = NodeBlock::get(this->store, currentRelation->destination.address);
             currentRelation = currentRelation->nextSource();
         } else if (currentRelation->destination.address == this->addr) {
-            node = NodeBlock::get(currentRelation->source.address);
+            node = NodeBlock::get(this->store, currentRelation->source.address);
             currentRelation = currentRelation->nextDestination();
         } else {
             throw "Error: Unrecognized relation for " + std::to_string(this->addr) + " in relation block " +
@@ -318,52 +330,26 @@ std::map<std::string, char*> NodeBlock::getAllProperties() {
     return allProperties;
 }
 
-NodeBlock* NodeBlock::get(unsigned int blockAddress) {
+NodeBlock* NodeBlock::get(StoreHandles* store, unsigned int blockAddress) {
     NodeBlock* nodeBlockPointer = NULL;
-    NodeBlock::nodesDB->seekg(blockAddress);
-    unsigned int nodeId;
-    unsigned int edgeRef;
-    unsigned int centralEdgeRef;
-    unsigned char edgeRefPID;
-    unsigned int propRef;
-    char usageBlock;
-    char label[NodeBlock::LABEL_SIZE];
+    NodeRecord record;
+    char label[NodeBlock::LABEL_SIZE + 1] = {0};
     std::string id;
 
-    if (!NodeBlock::nodesDB->get(usageBlock)) {
-        node_block_logger.error("Error while reading usage data from block " + std::to_string(blockAddress));
-    }
-    if (!NodeBlock::nodesDB->read(reinterpret_cast<char*>(&nodeId), sizeof(unsigned int))) {
-        node_block_logger.error("Error while reading nodeId  data from block " + std::to_string(blockAddress));
-    }
-    if (!NodeBlock::nodesDB->read(reinterpret_cast<char*>(&edgeRef), sizeof(unsigned int))) {
-        node_block_logger.error("Error while reading edge reference data from block " + std::to_string(blockAddress));
-    }
-    if (!NodeBlock::nodesDB->read(reinterpret_cast<char*>(&centralEdgeRef), sizeof(unsigned int))) {
-        node_block_logger.error("Error while reading central edge reference data from block " + std::to_string(blockAddress));
-    }
-
-    if (!NodeBlock::nodesDB->read(reinterpret_cast<char*>(&edgeRefPID), sizeof(unsigned char))) {
-        node_block_logger.error("Error while reading edge reference partition ID data from block " +
-                                std::to_string(blockAddress));
+    if (!store->nodesCache->read(blockAddress, &record)) {
+        node_block_logger.error("Error while reading node block " + std::to_string(blockAddress));
+        return NULL;
     }
-
-    if (!NodeBlock::nodesDB->read(reinterpret_cast<char*>(&propRef), sizeof(unsigned int))) {
-        node_block_logger.error("Error while reading prop reference data from block " + std::to_string(blockAddress));
-    }
-
-    if (!NodeBlock::nodesDB->read(&label[0], NodeBlock::LABEL_SIZE)) {
-        node_block_logger.error("Error while reading label data from block " + std::to_string(blockAddress));
-    }
-    bool usage = usageBlock == '\1';
-    node_block_logger.debug("Label = " + std::string(label));
+    std::memcpy(label, record.label, NodeBlock::LABEL_SIZE);
+    bool usage = record.usage == '\1';
     node_block_logger.debug("Label = " + std::string(label));
     node_block_logger.debug("Length of label = " + std::to_string(strlen(label)));
-    node_block_logger.debug("edgeRef = " + std::to_string(edgeRef));
+    node_block_logger.debug("edgeRef = " + std::to_string(record.edgeRef));
     if (strlen(label) != 0) {
         id = std::string(label);
     }
-    nodeBlockPointer = new NodeBlock(id, nodeId,blockAddress, propRef, edgeRef,centralEdgeRef, edgeRefPID, label, usage);
+    nodeBlockPointer = new NodeBlock(store, id, record.nodeId, blockAddress, record.propRef, record.edgeRef,
+                                     record.centralEdgeRef, record.edgeRefPID, label, usage);
     if (nodeBlockPointer->id.length() == 0) {  // if label not found in node block look in the properties
         std::map<std::string, char*> props = nodeBlockPointer->getAllProperties();
         if (props["label"]) {
@@ -380,5 +366,4 @@ NodeBlock* NodeBlock::get(unsigned int blockAddress) {
     return nodeBlockPointer;
 }
 
-PropertyLink* NodeBlock::getPropertyHead() { return PropertyLink::get(this->propRef); }
-std::fstream* NodeBlock::nodesDB = NULL;
\ No newline at end of file
+PropertyLink* NodeBlock::getPropertyHead() { return PropertyLink::get(this->store, this->propRef); }
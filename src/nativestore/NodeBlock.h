@@ -11,13 +11,16 @@ See the License for the specific language governing permissions and
 limitations under the License.
 **/
 
+#include <cstddef>
 #include <cstring>
 #include <fstream>
 #include <list>
 #include <map>
 #include <string>
 
+#include "BlockRecords.h"
 #include "PropertyLink.h"
+#include "StoreHandles.h"
 
 class RelationBlock;  // Forward declaration
 
@@ -29,6 +32,7 @@ class NodeBlock {
     bool isDirected = false;
 
    public:
+    StoreHandles *store = NULL;  // Database files of the store this block belongs to
     unsigned int addr = 0;
     std::string id = "";  // Node ID for this block ie: citation paper ID, Facebook accout ID, Twitter account ID etc
     char usage = false;   // Whether this block is in use or not
@@ -43,22 +47,21 @@ class NodeBlock {
     char label[LABEL_SIZE] = {
         0};  // Initialize with null chars label === ID if length(id) < 6 else ID will be stored as a Node's property
 
-    static std::fstream *nodesDB;
-
     /**
      * This constructor is used when creating a node for very first time.
      * Where user don't have properties DB address or edge DB addresses
      *
      **/
-    NodeBlock(std::string newId, unsigned int node, unsigned int address) {
+    NodeBlock(StoreHandles *nodeStore, std::string newId, unsigned int node, unsigned int address) {
+        store = nodeStore;
         id = newId;
         nodeId = node;
         addr = address;
         usage = true;
     };
 
-    NodeBlock(std::string id, unsigned int nodeId, unsigned int address, unsigned int propRef, unsigned int edgeRef,unsigned int centralEdgeRef,
-              unsigned char edgeRefPID, char _label[], bool usage);
+    NodeBlock(StoreHandles *store, std::string id, unsigned int nodeId, unsigned int address, unsigned int propRef,
+              unsigned int edgeRef, unsigned int centralEdgeRef, unsigned char edgeRefPID, char _label[], bool usage);
     bool updateRelation(RelationBlock *, bool relocateHead = true);
     void save();
     std::string getLabel();
@@ -66,12 +69,13 @@ class NodeBlock {
     std::map<std::string, char *> getProperty(std::string);
     PropertyLink *getPropertyHead();
     std::map<std::string, char *> getAllProperties();
-    static NodeBlock *get(unsigned int);
+    static NodeBlock *get(StoreHandles *, unsigned int);
     int getFlags();
     void addProperty(std::string, char *);
     RelationBlock *getRelationHead();
     std::list<NodeBlock> getEdges();
     bool setRelationHead(RelationBlock);
+    bool reloadRelationHeads();
     RelationBlock *searchRelation(NodeBlock);
 
     bool updateCentralRelation(RelationBlock *newRelation, bool relocateHead  = true);
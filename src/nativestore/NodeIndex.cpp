@@ -0,0 +1,311 @@
+/**
+Copyright 2023 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+**/
+
+#include "NodeIndex.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "../util/logger/Logger.h"
+
+Logger node_index_logger;
+
+NodeIndex::NodeIndex() {
+    pthread_rwlock_init(&resizeLock, NULL);
+    for (unsigned int i = 0; i < STRIPE_COUNT; i++) {
+        pthread_rwlock_init(&stripes[i], NULL);
+    }
+}
+
+NodeIndex::~NodeIndex() {
+    this->close();
+    pthread_rwlock_destroy(&resizeLock);
+    for (unsigned int i = 0; i < STRIPE_COUNT; i++) {
+        pthread_rwlock_destroy(&stripes[i]);
+    }
+}
+
+/**
+ * FNV-1a. The hash is persisted in the bucket layout, so it must not depend on the standard library in use
+ * */
+unsigned long NodeIndex::hashOf(const std::string &nodeId) {
+    unsigned long hashValue = 14695981039346656037UL;
+    for (unsigned char c : nodeId) {
+        hashValue ^= c;
+        hashValue *= 1099511628211UL;
+    }
+    return hashValue;
+}
+
+/**
+ * Open or create the index files <pathPrefix>.db, <pathPrefix>.hash.db and <pathPrefix>.chain.db
+ * */
+void NodeIndex::open(std::string pathPrefix, unsigned long keySize, bool truncate) {
+    this->keySize = keySize;
+    this->entrySize = keySize + sizeof(unsigned int);
+    this->entries = new MmapBlockFile(pathPrefix + ".db", truncate);
+    this->hash = new MmapBlockFile(pathPrefix + ".hash.db", truncate);
+    this->chain = new MmapBlockFile(pathPrefix + ".chain.db", truncate);
+    if (truncate) {
+        this->entryCount = 0;
+        this->rebuild(NodeIndex::MIN_BUCKETS);
+    } else {
+        this->recover();
+    }
+}
+
+/**
+ * Bring the hash files in line with the entry log after opening an existing index. Only entries appended after
+ * the last checkpoint are looked at, unless the hash files are missing or were built for another key size
+ * */
+void NodeIndex::recover() {
+    NodeIndexHeader header = {};
+    bool hashValid = this->hash->read(0, &header, sizeof(header)) && header.magic == NodeIndex::MAGIC &&
+                     header.version == NodeIndex::VERSION && header.keySize == this->keySize &&
+                     header.bucketCount >= NodeIndex::MIN_BUCKETS;
+    unsigned long fileEntries = this->entries->size() / this->entrySize;
+    if (hashValid && header.linkedEntries > fileEntries) {
+        hashValid = false;
+    }
+
+    // After an unclean shutdown the log still has the size of its last mapping, with unwritten (zero) entries at
+    // the end. Keys are never empty, so the log ends at the first entry with an empty key
+    unsigned long count = hashValid ? header.linkedEntries : 0;
+    char firstKeyByte = 0;
+    while (count < fileEntries && this->entries->read(count * this->entrySize, &firstKeyByte, 1) && firstKeyByte) {
+        count++;
+    }
+    this->entries->trim(count * this->entrySize);
+    this->entryCount = count;
+
+    if (!hashValid) {
+        unsigned long buckets = NodeIndex::MIN_BUCKETS;
+        while (buckets * NodeIndex::MAX_LOAD < count) {
+            buckets *= 2;
+        }
+        node_index_logger.info("Building node index hash for " + std::to_string(count) + " entries in " +
+                               this->entries->getPath());
+        this->rebuild(buckets);
+        return;
+    }
+
+    this->bucketCount = header.bucketCount;
+    std::vector<char> key(this->keySize + 1, 0);
+    unsigned int blockIndex;
+    for (unsigned long entry = header.linkedEntries; entry < count; entry++) {
+        this->entries->read(entry * this->entrySize, key.data(), this->keySize);
+        std::string nodeId(key.data());
+        unsigned long hashValue = NodeIndex::hashOf(nodeId);
+        if (!this->lookup(nodeId, hashValue, blockIndex)) {  // Linked before the crash but after the checkpoint
+            this->link(entry, hashValue);
+        }
+    }
+    this->writeHeader(count);
+}
+
+/**
+ * Throw away the bucket array and chains and link every entry of the log again with newBucketCount buckets.
+ * Caller must hold the resize lock exclusively (or be opening the index)
+ * */
+void NodeIndex::rebuild(unsigned long newBucketCount) {
+    this->bucketCount = newBucketCount;
+    this->writeHeader(0);  // Marks the hash as incomplete until the rebuild is done
+
+    std::vector<char> zeros(64 * 1024, 0);
+    unsigned long bucketBytes = newBucketCount * sizeof(unsigned int);
+    for (unsigned long written = 0; written < bucketBytes; written += zeros.size()) {
+        unsigned long length = std::min((unsigned long)zeros.size(), bucketBytes - written);
+        this->hash->write(this->bucketOffset(0) + written, zeros.data(), length);
+    }
+
+    unsigned long count = this->entryCount.load();
+    std::vector<char> key(this->keySize + 1, 0);
+    for (unsigned long entry = 0; entry < count; entry++) {
+        this->entries->read(entry * this->entrySize, key.data(), this->keySize);
+        this->link(entry, NodeIndex::hashOf(std::string(key.data())));
+    }
+    this->writeHeader(count);
+}
+
+bool NodeIndex::writeHeader(unsigned long linkedEntries) {
+    NodeIndexHeader header = {};
+    header.magic = NodeIndex::MAGIC;
+    header.version = NodeIndex::VERSION;
+    header.bucketCount = this->bucketCount;
+    header.keySize = this->keySize;
+    header.linkedEntries = linkedEntries;
+    return this->hash->write(0, &header, sizeof(header));
+}
+
+/**
+ * Push an entry that is already in the log to the front of its bucket chain. Caller must hold the stripe of the
+ * bucket exclusively
+ * */
+void NodeIndex::link(unsigned int entry, unsigned long hashValue) {
+    unsigned long bucketAddress = this->bucketOffset(hashValue & (this->bucketCount - 1));
+    unsigned int head = 0;
+    this->hash->read(bucketAddress, &head, sizeof(head));
+    this->chain->write(entry * sizeof(unsigned int), &head, sizeof(head));
+    unsigned int newHead = entry + 1;
+    this->hash->write(bucketAddress, &newHead, sizeof(newHead));
+}
+
+bool NodeIndex::keyMatches(unsigned int entry, const std::string &nodeId) {
+    // Keys are null padded up to keySize, so compare the ID and the byte after it (if there is one)
+    unsigned long length = std::min(nodeId.length() + 1, this->keySize);
+    char stored[64];
+    std::vector<char> largeKey;
+    char *key = stored;
+    if (length > sizeof(stored)) {
+        largeKey.resize(length);
+        key = largeKey.data();
+    }
+    if (!this->entries->read(entry * this->entrySize, key, length)) {
+        return false;
+    }
+    return std::memcmp(key, nodeId.c_str(), length) == 0;
+}
+
+/**
+ * Walk the bucket chain of the given ID. Caller must hold the stripe of the bucket
+ * */
+bool NodeIndex::lookup(const std::string &nodeId, unsigned long hashValue, unsigned int &blockIndex) {
+    unsigned int head = 0;
+    this->hash->read(this->bucketOffset(hashValue & (this->bucketCount - 1)), &head, sizeof(head));
+    while (head) {
+        unsigned int entry = head - 1;
+        if (this->keyMatches(entry, nodeId)) {
+            return this->entries->read(entry * this->entrySize + this->keySize, &blockIndex, sizeof(blockIndex));
+        }
+        if (!this->chain->read(entry * sizeof(unsigned int), &head, sizeof(head))) {
+            node_index_logger.error("Broken node index chain at entry " + std::to_string(entry));
+            return false;
+        }
+    }
+    return false;
+}
+
+bool NodeIndex::find(const std::string &nodeId, unsigned int &blockIndex) {
+    unsigned long hashValue = NodeIndex::hashOf(nodeId);
+    pthread_rwlock_rdlock(&resizeLock);
+    pthread_rwlock_t *stripe = this->stripeOf(hashValue);
+    pthread_rwlock_rdlock(stripe);
+    bool found = this->lookup(nodeId, hashValue, blockIndex);
+    pthread_rwlock_unlock(stripe);
+    pthread_rwlock_unlock(&resizeLock);
+    return found;
+}
+
+bool NodeIndex::contains(const std::string &nodeId) {
+    unsigned int blockIndex;
+    return this->find(nodeId, blockIndex);
+}
+
+/**
+ * Return the block index of the given node ID, calling create() to allocate one if the ID is not indexed yet.
+ *
+ * create() runs while the stripe is write locked, so a node block is allocated and saved exactly once even when
+ * several threads add the same node at the same time, and no other thread can see the new index before the block
+ * is on disk.
+ * */
+unsigned int NodeIndex::findOrInsert(const std::string &nodeId, std::function<unsigned int()> create,
+                                     bool &inserted) {
+    unsigned int blockIndex;
+    inserted = false;
+    if (this->find(nodeId, blockIndex)) {  // Fast path, most edges connect already known nodes
+        return blockIndex;
+    }
+    if (nodeId.length() > this->keySize) {
+        node_index_logger.error("Node label/ID is longer ( " + std::to_string(nodeId.length()) +
+                                " ) than the index key size " + std::to_string(this->keySize));
+        throw "Node label/ID is longer than the index key size!";
+    }
+
+    unsigned long hashValue = NodeIndex::hashOf(nodeId);
+    pthread_rwlock_rdlock(&resizeLock);
+    pthread_rwlock_t *stripe = this->stripeOf(hashValue);
+    pthread_rwlock_wrlock(stripe);
+    if (!this->lookup(nodeId, hashValue, blockIndex)) {  // Not added by another thread after the fast path lookup
+        blockIndex = create();
+        unsigned int entry = this->entryCount++;
+        std::vector<char> record(this->entrySize, 0);
+        std::memcpy(record.data(), nodeId.c_str(), nodeId.length());
+        std::memcpy(record.data() + this->keySize, &blockIndex, sizeof(blockIndex));
+        if (this->entries->write(entry * this->entrySize, record.data(), record.size())) {
+            this->link(entry, hashValue);
+            inserted = true;
+        } else {
+            node_index_logger.error("Error while appending node " + nodeId + " to the node index");
+        }
+    }
+    pthread_rwlock_unlock(stripe);
+    bool grow = this->entryCount.load() > this->bucketCount * NodeIndex::MAX_LOAD;
+    pthread_rwlock_unlock(&resizeLock);
+
+    if (grow) {
+        pthread_rwlock_wrlock(&resizeLock);
+        if (this->entryCount.load() > this->bucketCount * NodeIndex::MAX_LOAD) {  // Not grown by another thread
+            this->rebuild(this->bucketCount * 2);
+        }
+        pthread_rwlock_unlock(&resizeLock);
+    }
+    return blockIndex;
+}
+
+/**
+ * Visit every entry in insertion order. Iteration stops when visit() returns false
+ * */
+void NodeIndex::forEach(std::function<bool(const std::string &, unsigned int)> visit) {
+    unsigned long count = this->entryCount.load();
+    std::vector<char> record(this->entrySize + 1, 0);
+    for (unsigned long entry = 0; entry < count; entry++) {
+        if (!this->entries->read(entry * this->entrySize, record.data(), this->entrySize) || record[0] == 0) {
+            continue;  // Slot taken by an insert that has not written it yet
+        }
+        unsigned int blockIndex;
+        std::memcpy(&blockIndex, record.data() + this->keySize, sizeof(blockIndex));
+        std::string nodeId(record.data(), strnlen(record.data(), this->keySize));
+        if (!visit(nodeId, blockIndex)) {
+            return;
+        }
+    }
+}
+
+/**
+ * Record that every entry so far is linked and flush the index files, so the next open has nothing to replay
+ * */
+void NodeIndex::checkpoint() {
+    if (!this->hash) {
+        return;
+    }
+    pthread_rwlock_wrlock(&resizeLock);  // Wait for inserts in flight
+    this->writeHeader(this->entryCount.load());
+    this->entries->sync();
+    this->hash->sync();
+    this->chain->sync();
+    pthread_rwlock_unlock(&resizeLock);
+}
+
+void NodeIndex::close() {
+    if (!this->hash) {
+        return;
+    }
+    this->checkpoint();
+    delete this->entries;
+    delete this->hash;
+    delete this->chain;
+    this->entries = NULL;
+    this->hash = NULL;
+    this->chain = NULL;
+}
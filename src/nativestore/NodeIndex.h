@@ -0,0 +1,99 @@
+/**
+Copyright 2023 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+**/
+
+#include <pthread.h>
+
+#include <atomic>
+#include <functional>
+#include <string>
+
+#include "MmapBlockFile.h"
+
+#ifndef NODE_INDEX
+#define NODE_INDEX
+
+#pragma pack(push, 1)
+// First bytes of <graph>_<partition>_nodes.index.hash.db, followed by bucketCount bucket heads
+struct NodeIndexHeader {
+    unsigned int magic;
+    unsigned short version;
+    unsigned short reserved;
+    unsigned long bucketCount;    // Always a power of two
+    unsigned long keySize;        // Key width of the entry log this hash was built for
+    unsigned long linkedEntries;  // Entries known to be linked into the hash at the last checkpoint
+};
+#pragma pack(pop)
+
+/**
+ * Persistent, memory mapped hash index from node ID/label to node block index in the nodes DB.
+ *
+ * The index consists of three files:
+ *  <prefix>.db       Append only log of fixed width entries, keySize bytes of key followed by the block index.
+ *                    This is the same layout the whole index used to be rewritten in on close, so existing index
+ *                    files are picked up as they are.
+ *  <prefix>.hash.db  NodeIndexHeader and the bucket heads (entry number + 1, 0 for an empty bucket)
+ *  <prefix>.chain.db Next entry number + 1 of every entry in its bucket chain
+ *
+ * Nothing is loaded into memory on open. Adding a node appends one entry and one chain link and points its bucket
+ * at the new entry, so the index on disk is always up to date. Opening replays only the entries appended after the
+ * last checkpoint, and rebuilds the hash files from the log if they are missing (ie: index files written by older
+ * versions). The bucket array doubles when the average chain length goes over MAX_LOAD.
+ *
+ * Buckets are guarded by STRIPE_COUNT reader/writer locks, so concurrent ingest threads only contend when their
+ * node IDs hash to the same stripe.
+ **/
+class NodeIndex {
+   private:
+    static const unsigned int STRIPE_COUNT = 64;
+    static const unsigned long MIN_BUCKETS = 1024;
+    static const unsigned long MAX_LOAD = 2;
+    static const unsigned int MAGIC = 0x4a474e49;  // "JGNI"
+    static const unsigned short VERSION = 1;
+
+    MmapBlockFile *entries = NULL;
+    MmapBlockFile *hash = NULL;
+    MmapBlockFile *chain = NULL;
+    unsigned long keySize = 0;
+    unsigned long entrySize = 0;
+    unsigned long bucketCount = 0;
+    std::atomic<unsigned int> entryCount{0};
+    pthread_rwlock_t resizeLock;  // Shared by every lookup and insert, exclusive while the bucket array grows
+    pthread_rwlock_t stripes[STRIPE_COUNT];
+
+    static unsigned long hashOf(const std::string &nodeId);
+    unsigned long bucketOffset(unsigned long bucket) {
+        return sizeof(NodeIndexHeader) + bucket * sizeof(unsigned int);
+    };
+    pthread_rwlock_t *stripeOf(unsigned long hashValue) { return &stripes[hashValue % STRIPE_COUNT]; };
+    bool lookup(const std::string &nodeId, unsigned long hashValue, unsigned int &blockIndex);
+    bool keyMatches(unsigned int entry, const std::string &nodeId);
+    void link(unsigned int entry, unsigned long hashValue);
+    void rebuild(unsigned long newBucketCount);
+    void recover();
+    bool writeHeader(unsigned long linkedEntries);
+
+   public:
+    NodeIndex();
+    ~NodeIndex();
+
+    void open(std::string pathPrefix, unsigned long keySize, bool truncate);
+    bool find(const std::string &nodeId, unsigned int &blockIndex);
+    bool contains(const std::string &nodeId);
+    unsigned int findOrInsert(const std::string &nodeId, std::function<unsigned int()> create, bool &inserted);
+    void forEach(std::function<bool(const std::string &, unsigned int)> visit);
+    unsigned long size() { return entryCount.load(); };
+    void checkpoint();
+    void close();
+};
+
+#endif
@@ -13,7 +13,7 @@ limitations under the License.
 
 #include "NodeManager.h"
 
-#include <sys/stat.h>
+#include <algorithm>
 #include <mutex>
 #include <exception>
 
@@ -26,10 +26,6 @@ limitations under the License.
 #include "iostream"
 
 Logger node_manager_logger;
-//std::mutex lockEdgeAdd;
-//std::mutex lockCentralEdgeAdd;
-pthread_mutex_t lockEdgeAdd;
-pthread_mutex_t lockCentralEdgeAdd;
 
 NodeManager::NodeManager(GraphConfig gConfig) {
     this->graphID = gConfig.graphID;
@@ -47,73 +43,87 @@ NodeManager::NodeManager(GraphConfig gConfig) {
     if (gConfig.maxLabelSize) {
         setIndexKeySize(gConfig.maxLabelSize);
     }
-    std::ios_base::openmode openMode = std::ios::trunc;  // default is Trunc mode which overrides the entire file
+    bool truncate = true;  // default is Trunc mode which overrides the entire file
     if (gConfig.openMode == NodeManager::FILE_MODE) {
-        openMode = std::ios::app;  // if app, open in append mode
-        this->nodeIndex = readNodeIndex();
+        truncate = false;  // if app, keep the existing data
     }
-    NodeBlock::nodesDB = new std::fstream(nodesDBPath, std::ios::in | std::ios::out | openMode | std::ios::binary);
-    PropertyLink::propertiesDB =
-        new std::fstream(dbPrefix + "_properties.db", std::ios::in | std::ios::out | openMode | std::ios::binary);
-    PropertyEdgeLink::edgePropertiesDB =
-            new std::fstream(dbPrefix + "_edge_properties.db", std::ios::in | std::ios::out | openMode | std::ios::binary);
-
-    RelationBlock::relationsDB =
-        new std::fstream(dbPrefix + "_relations.db", std::ios::in | std::ios::out | openMode | std::ios::binary);
-    RelationBlock::centralrelationsDB =
-            new std::fstream(dbPrefix + "_central_relations.db", std::ios::in | std::ios::out | openMode | std::ios::binary);
-//    RelationBlock::centralpropertiesDB =
-//            new std::fstream(dbPrefix + "_central_relations.db", std::ios::in | std::ios::out | openMode | std::ios::binary);
-    // TODO (tmkasun): set PropertyLink nextPropertyIndex after validating by modulus check from file number of bytes
-
-    if (dbSize(nodesDBPath) % NodeBlock::BLOCK_SIZE != 0) {
+    // Opens in place. Only the entries added since the last checkpoint are looked at when appending
+    this->nodeIndex.open(dbPrefix + "_nodes.index", NodeManager::INDEX_KEY_SIZE, truncate);
+    pthread_mutex_init(&this->store.propertyLock, NULL);
+
+    this->store.nodesDB = new MmapBlockFile(nodesDBPath, truncate);
+    this->store.propertiesDB = new MmapBlockFile(dbPrefix + "_properties.db", truncate);
+    this->store.edgePropertiesDB = new MmapBlockFile(dbPrefix + "_edge_properties.db", truncate);
+    this->store.relationsDB = new MmapBlockFile(dbPrefix + "_relations.db", truncate);
+    this->store.centralRelationsDB = new MmapBlockFile(dbPrefix + "_central_relations.db", truncate);
+
+    // Half of the block cache budget goes to local relations, which are walked the most
+    unsigned long cacheBudget = this->blockCacheBudget();
+    this->store.nodesCache = new BlockCache(this->store.nodesDB, NodeBlock::BLOCK_SIZE, cacheBudget / 4);
+    this->store.relationsCache = new BlockCache(this->store.relationsDB, RelationBlock::BLOCK_SIZE, cacheBudget / 2);
+    this->store.centralRelationsCache =
+        new BlockCache(this->store.centralRelationsDB, RelationBlock::BLOCK_SIZE, cacheBudget / 4);
+
+    if (this->store.nodesDB->size() % NodeBlock::BLOCK_SIZE != 0) {
         std::string errorMessage =
-            "Node DB size does not comply to node block size Path = " + NodeManager::NODE_DB_PATH;
+            "Node DB size does not comply to node block size Path = " + nodesDBPath;
         node_manager_logger.error(errorMessage);
         throw std::runtime_error(errorMessage);
     }
-}
 
-std::unordered_map<std::string, unsigned int> NodeManager::readNodeIndex() {
-    std::ifstream index_db(this->index_db_loc, std::ios::app | std::ios::binary);
-    std::unordered_map<std::string, unsigned int> _nodeIndex;  // temporary node index data holder
+    // Resume allocation after the last block of each file when appending. Relation and property files never use
+    // block 0, so an empty file still starts at index 1
+    this->nextNodeIndex = this->store.nodesDB->size() / NodeBlock::BLOCK_SIZE;
+    this->store.nextRelationIndex = std::max(1UL, this->store.relationsDB->size() / RelationBlock::BLOCK_SIZE);
+    this->store.nextCentralRelationIndex =
+        std::max(1UL, this->store.centralRelationsDB->size() / RelationBlock::BLOCK_SIZE);
+    this->store.nextPropertyIndex =
+        std::max(1UL, this->store.propertiesDB->size() / PropertyLink::PROPERTY_BLOCK_SIZE);
+    this->store.nextEdgePropertyIndex =
+        std::max(1UL, this->store.edgePropertiesDB->size() / PropertyEdgeLink::PROPERTY_BLOCK_SIZE);
+}
 
-    if (index_db.is_open()) {
-        int iSize = dbSize(this->index_db_loc);
-        unsigned long dataWidth = NodeManager::INDEX_KEY_SIZE + sizeof(unsigned int);
-        if (iSize % dataWidth != 0) {
-            node_manager_logger.error("Index DB size does not comply to index block size Path = " + this->index_db_loc);
-            throw std::runtime_error("Node index DB in " + this->index_db_loc + " is corrupted!");
-        }
+NodeManager::~NodeManager() {
+    delete this->store.nodesCache;
+    delete this->store.relationsCache;
+    delete this->store.centralRelationsCache;
+    delete this->store.nodesDB;
+    delete this->store.relationsDB;
+    delete this->store.centralRelationsDB;
+    delete this->store.propertiesDB;
+    delete this->store.edgePropertiesDB;
+    pthread_mutex_destroy(&this->store.propertyLock);
+}
 
-        char nodeIDC[NodeManager::INDEX_KEY_SIZE];
-        unsigned int nodeIndexId;
-        for (size_t i = 0; i < iSize / dataWidth; i++) {
-            nodeIDC[NodeManager::INDEX_KEY_SIZE] = {0};  // Fill with null chars before putting data
-            if (!index_db.read(&nodeIDC[0], NodeManager::INDEX_KEY_SIZE)) {
-                node_manager_logger.error("Error while reading index key data from block i = " + std::to_string(i));
-            }
-            if (!index_db.read(reinterpret_cast<char *>(&nodeIndexId), sizeof(unsigned int))) {
-                node_manager_logger.error("Error while reading index ID data from block i = " + std::to_string(i));
-            }
-            _nodeIndex[std::string(nodeIDC)] = nodeIndexId;
-        }
+/**
+ * Lock both end nodes of a new relation. The locks are always taken in the same global order (std::lock) so two
+ * threads adding a->b and b->a can not deadlock, and a self loop or a stripe collision only locks once
+ * */
+static void lockRelationEnds(std::unique_lock<std::mutex> &sourceGuard,
+                             std::unique_lock<std::mutex> &destinationGuard) {
+    if (sourceGuard.mutex() == destinationGuard.mutex()) {
+        sourceGuard.lock();
     } else {
-        std::string errorMessage = "Error while opening the node index DB";
-        node_manager_logger.error(errorMessage);
-        throw std::runtime_error(errorMessage);
+        std::lock(sourceGuard, destinationGuard);
     }
-
-    index_db.close();
-    return _nodeIndex;
 }
 
+/**
+ * Only the two end nodes are locked while the duplicate check runs and the new relation is spliced in front of
+ * their relation lists, so edges between unrelated nodes are added in parallel
+ * */
 RelationBlock *NodeManager::addRelation(NodeBlock source, NodeBlock destination) {
     RelationBlock *newRelation = NULL;
+    std::unique_lock<std::mutex> sourceGuard(this->nodeLock(source), std::defer_lock);
+    std::unique_lock<std::mutex> destinationGuard(this->nodeLock(destination), std::defer_lock);
+    lockRelationEnds(sourceGuard, destinationGuard);
+    if (!source.reloadRelationHeads() || !destination.reloadRelationHeads()) {
+        return newRelation;
+    }
+
     if (source.edgeRef == 0 || destination.edgeRef == 0 ||
         !source.searchRelation(destination)) {  // certainly a new relation block needed
-        RelationBlock *relationBlock = new RelationBlock(source,destination);
-        newRelation = relationBlock->add(source, destination);
+        newRelation = RelationBlock::add(source, destination);
         if (newRelation) {
             source.updateRelation(newRelation);
             destination.updateRelation(newRelation);
@@ -133,6 +143,13 @@ RelationBlock *NodeManager::addRelation(NodeBlock source, NodeBlock destination)
 
 RelationBlock *NodeManager::addCentralRelation(NodeBlock source, NodeBlock destination) {
     RelationBlock *newRelation = NULL;
+    std::unique_lock<std::mutex> sourceGuard(this->nodeLock(source), std::defer_lock);
+    std::unique_lock<std::mutex> destinationGuard(this->nodeLock(destination), std::defer_lock);
+    lockRelationEnds(sourceGuard, destinationGuard);
+    if (!source.reloadRelationHeads() || !destination.reloadRelationHeads()) {
+        return newRelation;
+    }
+
     if (source.centralEdgeRef == 0 || destination.centralEdgeRef == 0 ||
         !source.searchCentralRelation(destination)) {  // certainly a new relation block needed
         newRelation = RelationBlock::addCentral(source, destination);
@@ -154,27 +171,27 @@ RelationBlock *NodeManager::addCentralRelation(NodeBlock source, NodeBlock desti
 }
 
 NodeBlock *NodeManager::addNode(std::string nodeId) {
-    unsigned int assignedNodeIndex;
-    node_manager_logger.debug("Adding node index " + std::to_string(this->nextNodeIndex));
-    if (this->nodeIndex.find(nodeId) == this->nodeIndex.end()) {
-        node_manager_logger.debug("Can't find NodeId (" + nodeId + ") in the index database");
-        unsigned int vertexId = std::stoul(nodeId);
-        NodeBlock *sourceBlk = new NodeBlock(nodeId, vertexId,this->nextNodeIndex * NodeBlock::BLOCK_SIZE);
-        this->nodeIndex.insert({nodeId, this->nextNodeIndex});
-        assignedNodeIndex = this->nextNodeIndex;
-        this->nextNodeIndex++;
-        sourceBlk->save();
+    NodeBlock *sourceBlk = NULL;
+    bool inserted = false;
+    unsigned int vertexId = std::stoul(nodeId);  // Parsed up front so a bad ID can't throw with the index locked
+    unsigned int assignedNodeIndex = this->nodeIndex.findOrInsert(
+        nodeId,
+        [&]() {
+            unsigned int newNodeIndex = this->nextNodeIndex++;
+            sourceBlk = new NodeBlock(&this->store, nodeId, vertexId, newNodeIndex * NodeBlock::BLOCK_SIZE);
+            sourceBlk->save();
+            return newNodeIndex;
+        },
+        inserted);
+    if (inserted) {
+        node_manager_logger.debug("Added node index " + std::to_string(assignedNodeIndex) + " for " + nodeId);
         return sourceBlk;
-    } else {
-        node_manager_logger.debug("NodeId found in index for node ID " + nodeId);
-        return this->get(nodeId);
     }
+    node_manager_logger.debug("NodeId found in index for node ID " + nodeId);
+    return this->readNode(nodeId, assignedNodeIndex);
 }
 
 RelationBlock *NodeManager::addEdge(std::pair<std::string, std::string> edge) {
-
-    pthread_mutex_lock(&lockEdgeAdd);
-
     NodeBlock *sourceNode = this->addNode(edge.first);
     NodeBlock *destNode = this->addNode(edge.second);
     RelationBlock *newRelation = this->addRelation(*sourceNode, *destNode);
@@ -182,7 +199,6 @@ RelationBlock *NodeManager::addEdge(std::pair<std::string, std::string> edge) {
         newRelation->setDestination(destNode);
         newRelation->setSource(sourceNode);
     }
-    pthread_mutex_unlock(&lockEdgeAdd);
 
     node_manager_logger.debug("DEBUG: Source DB block address " + std::to_string(sourceNode->addr) +
                               " Destination DB block address " + std::to_string(destNode->addr));
@@ -190,11 +206,6 @@ RelationBlock *NodeManager::addEdge(std::pair<std::string, std::string> edge) {
 }
 
 RelationBlock *NodeManager::addCentralEdge(std::pair<std::string, std::string> edge) {
-//    std::unique_lock<std::mutex> guard1(lockCentralEdgeAdd);
-//
-//    guard1.lock();
-    pthread_mutex_lock(&lockCentralEdgeAdd);
-
     NodeBlock *sourceNode = this->addNode(edge.first);
     NodeBlock *destNode = this->addNode(edge.second);
     RelationBlock *newRelation = this->addCentralRelation(*sourceNode, *destNode);
@@ -202,94 +213,40 @@ RelationBlock *NodeManager::addCentralEdge(std::pair<std::string, std::string> e
         newRelation->setDestination(destNode);
         newRelation->setSource(sourceNode);
     }
-    pthread_mutex_unlock(&lockCentralEdgeAdd);
-
-//    guard1.unlock();
     node_manager_logger.debug("DEBUG: Source DB block address " + std::to_string(sourceNode->addr) +
                               " Destination DB block address " + std::to_string(destNode->addr));
     return newRelation;
 }
 
-int NodeManager::dbSize(std::string path) {
-    /*
-        The structure stat contains at least the following members:
-        st_dev     ID of the device containing file
-        st_ino     file serial number
-        st_mode    mode of file (see below)
-        st_nlink   number of links to the file
-        st_uid     user ID of file
-        st_gid     group ID of file
-        st_rdev    device ID (if file is character or block special)
-        st_size    file size in bytes (if file is a regular file)
-        st_atime   time of last access
-        st_mtime   time of last data modification
-        st_ctime   time of last status change
-        st_blksize a filesystem-specific preferred I/O block size for
-                        this object.  In some filesystem types, this may
-                        vary from file to file
-        st_blocks  number of blocks allocated for this object
-    */
-    struct stat result;
-    if (stat(path.c_str(), &result) == 0) {
-        node_manager_logger.debug("Size of the " + path + " is " + std::to_string(result.st_size));
-    } else {
-        node_manager_logger.error("Error while reading file stats in " + path);
-        return -1;
-    }
-
-    return result.st_size;
-}
-
 /**
  * @Deprecated use NodeBlock.get() instead
  **/
 NodeBlock *NodeManager::get(std::string nodeId) {
-    NodeBlock *nodeBlockPointer = NULL;
-    if (this->nodeIndex.find(nodeId) == this->nodeIndex.end()) {  // Not found
-        return nodeBlockPointer;
-    }
-    unsigned int nodeIndex = this->nodeIndex[nodeId];
-    const unsigned int blockAddress = nodeIndex * NodeBlock::BLOCK_SIZE;
-    NodeBlock::nodesDB->seekg(blockAddress);
-    unsigned int vertexId;
-    unsigned int edgeRef;
-    unsigned int centralEdgeRef;
-    unsigned char edgeRefPID;
-    unsigned int propRef;
-    char usageBlock;
-    char label[NodeBlock::LABEL_SIZE];
-
-    if (!NodeBlock::nodesDB->get(usageBlock)) {
-        node_manager_logger.error("Error while reading usage data from block " + std::to_string(blockAddress));
-    }
-    if (!NodeBlock::nodesDB->read(reinterpret_cast<char*>(&vertexId), sizeof(unsigned int))) {
-        node_manager_logger.error("Error while reading nodeId  data from block " + std::to_string(blockAddress));
-    }
-    if (!NodeBlock::nodesDB->read(reinterpret_cast<char *>(&edgeRef), sizeof(unsigned int))) {
-        node_manager_logger.error("Error while reading edge reference data from block " + std::to_string(blockAddress));
-    }
-
-    if (!NodeBlock::nodesDB->read(reinterpret_cast<char *>(&centralEdgeRef), sizeof(unsigned int))) {
-        node_manager_logger.error("Error while reading central edge reference data from block " + std::to_string(blockAddress));
-    }
-
-    if (!NodeBlock::nodesDB->read(reinterpret_cast<char *>(&edgeRefPID), sizeof(unsigned char))) {
-        node_manager_logger.error("Error while reading usage data from block " + std::to_string(blockAddress));
+    unsigned int nodeIndex;
+    if (!this->nodeIndex.find(nodeId, nodeIndex)) {  // Not found
+        return NULL;
     }
+    return this->readNode(nodeId, nodeIndex);
+}
 
-    if (!NodeBlock::nodesDB->read(reinterpret_cast<char *>(&propRef), sizeof(unsigned int))) {
-        node_manager_logger.error("Error while reading prop reference data from block " + std::to_string(blockAddress));
-    }
+NodeBlock *NodeManager::readNode(std::string nodeId, unsigned int nodeIndex) {
+    NodeBlock *nodeBlockPointer = NULL;
+    const unsigned int blockAddress = nodeIndex * NodeBlock::BLOCK_SIZE;
+    NodeRecord record;
+    char label[NodeBlock::LABEL_SIZE + 1] = {0};
 
-    if (!NodeBlock::nodesDB->read(&label[0], NodeBlock::LABEL_SIZE)) {
-        node_manager_logger.error("Error while reading label data from block " + std::to_string(blockAddress));
+    if (!this->store.nodesCache->read(blockAddress, &record)) {
+        node_manager_logger.error("Error while reading node block " + std::to_string(blockAddress));
+        return nodeBlockPointer;
     }
-    bool usage = usageBlock == '\1';
+    std::memcpy(label, record.label, NodeBlock::LABEL_SIZE);
+    bool usage = record.usage == '\1';
     node_manager_logger.debug("Label = " + std::string(label));
     node_manager_logger.debug("Length of label = " + std::to_string(strlen(label)));
-    node_manager_logger.debug("DEBUG: raw edgeRef from DB (disk) " + std::to_string(edgeRef));
+    node_manager_logger.debug("DEBUG: raw edgeRef from DB (disk) " + std::to_string(record.edgeRef));
 
-    nodeBlockPointer = new NodeBlock(nodeId,vertexId, blockAddress, propRef, edgeRef,centralEdgeRef, edgeRefPID, label, usage);
+    nodeBlockPointer = new NodeBlock(&this->store, nodeId, record.nodeId, blockAddress, record.propRef,
+                                     record.edgeRef, record.centralEdgeRef, record.edgeRefPID, label, usage);
 
     node_manager_logger.debug("DEBUG: nodeBlockPointer after creating the object edgeRef " +
                               std::to_string(nodeBlockPointer->edgeRef));
@@ -300,42 +257,22 @@ NodeBlock *NodeManager::get(std::string nodeId) {
     return nodeBlockPointer;
 }
 
-void NodeManager::persistNodeIndex() {
-    std::ofstream index_db(this->index_db_loc, std::ios::trunc | std::ios::binary);
-    if (index_db.is_open()) {
-        if (this->nodeIndex.size() > 0 && (this->nodeIndex.begin()->first.length() > NodeManager::INDEX_KEY_SIZE)) {
-            node_manager_logger.error("Node label/ID is longer ( " +
-                                      std::to_string(this->nodeIndex.begin()->first.length()) +
-                                      " ) than the index key size " + std::to_string(NodeManager::INDEX_KEY_SIZE));
-            throw "Node label/ID is longer than the index key size!";
-        }
-        for (auto nodeMap : this->nodeIndex) {
-            char nodeIDC[NodeManager::INDEX_KEY_SIZE] = {0};  // Initialize with null chars
-            std::strcpy(nodeIDC, nodeMap.first.c_str());
-            index_db.write(nodeIDC, sizeof(nodeIDC));
-            unsigned int nodeBlockIndex = nodeMap.second;
-            index_db.write(reinterpret_cast<char *>(&(nodeBlockIndex)), sizeof(unsigned int));
-            node_manager_logger.debug("Writing node index --> Node key = " + std::string(nodeIDC) + " value " +
-                                      std::to_string(nodeBlockIndex));
-        }
-    }
-    index_db.close();
-}
-
 /**
  * Return the number of nodes upto the limit given in the arg from nodes index
  * Default limit is 10
  * */
 std::list<NodeBlock> NodeManager::getGraph(int limit) {
-    int i = 0;
-    std::list<NodeBlock> vertices;
-    for (auto it : this->nodeIndex) {
-        i++;
-        if (i > limit) {
-            break;
+    std::list<std::pair<std::string, unsigned int>> nodes;
+    this->nodeIndex.forEach([&](const std::string &nodeId, unsigned int nodeBlockIndex) {
+        if (nodes.size() >= (unsigned long)limit) {
+            return false;
         }
-        auto nodeId = it.first;
-        NodeBlock *node = this->get(nodeId);
+        nodes.push_back({nodeId, nodeBlockIndex});
+        return true;
+    });
+    std::list<NodeBlock> vertices;
+    for (auto it : nodes) {
+        NodeBlock *node = this->readNode(it.first, it.second);
         vertices.push_back(*node);
     }
     return vertices;
@@ -344,26 +281,79 @@ std::list<NodeBlock> NodeManager::getGraph(int limit) {
 /**
  *
  * When closing the node manager,
- * It closes all the open databases and persist the node index in-memory hash map to node index database
+ * It closes all the open databases including the node index
  *
  * **/
 void NodeManager::close() {
-    this->persistNodeIndex();
-    if (PropertyLink::propertiesDB) {
-        PropertyLink::propertiesDB->flush();
-        PropertyLink::propertiesDB->close();
+    this->nodeIndex.close();
+    this->logCacheStats();
+    if (this->store.propertiesDB) {
+        this->store.propertiesDB->close();
+    }
+    if (this->store.edgePropertiesDB) {
+        this->store.edgePropertiesDB->close();
+    }
+    if (this->store.nodesDB) {
+        this->store.nodesDB->close();
+    }
+    if (this->store.relationsDB) {
+        this->store.relationsDB->close();
     }
-    if (NodeBlock::nodesDB) {
-        NodeBlock::nodesDB->flush();
-        NodeBlock::nodesDB->close();
+    if (this->store.centralRelationsDB) {
+        this->store.centralRelationsDB->close();
     }
-    if (RelationBlock::relationsDB) {
-        RelationBlock::relationsDB->flush();
-        RelationBlock::relationsDB->close();
+}
+
+/**
+ * Flush the memory mapped store files to disk without closing them
+ * */
+void NodeManager::checkpoint() {
+    this->nodeIndex.checkpoint();
+    if (this->store.propertiesDB) {
+        this->store.propertiesDB->sync();
+    }
+    if (this->store.edgePropertiesDB) {
+        this->store.edgePropertiesDB->sync();
     }
-    if (RelationBlock::centralrelationsDB) {
-        RelationBlock::centralrelationsDB->flush();
-        RelationBlock::centralrelationsDB->close();
+    if (this->store.nodesDB) {
+        this->store.nodesDB->sync();
+    }
+    if (this->store.relationsDB) {
+        this->store.relationsDB->sync();
+    }
+    if (this->store.centralRelationsDB) {
+        this->store.centralRelationsDB->sync();
+    }
+}
+
+/**
+ * Block cache budget of this store in bytes, read from org.jasminegraph.nativestore.blockcache.mb. Zero disables
+ * the cache
+ * */
+unsigned long NodeManager::blockCacheBudget() {
+    Utils utils;
+    unsigned long budgetMB = NodeManager::DEFAULT_BLOCK_CACHE_MB;
+    try {
+        budgetMB = std::stoul(utils.getJasmineGraphProperty("org.jasminegraph.nativestore.blockcache.mb"));
+    } catch (std::exception &e) {
+        node_manager_logger.warn("Block cache size is not configured. Using the default of " +
+                                 std::to_string(budgetMB) + " MB");
+    }
+    return budgetMB * 1024 * 1024;
+}
+
+void NodeManager::logCacheStats() {
+    BlockCache *caches[] = {this->store.nodesCache, this->store.relationsCache, this->store.centralRelationsCache};
+    std::string names[] = {"nodes", "relations", "central relations"};
+    for (int i = 0; i < 3; i++) {
+        if (!caches[i]) {
+            continue;
+        }
+        node_manager_logger.info("Block cache of g" + std::to_string(this->graphID) + "_p" +
+                                 std::to_string(this->partitionID) + " " + names[i] + ": " +
+                                 std::to_string(caches[i]->getHits()) + " hits, " +
+                                 std::to_string(caches[i]->getMisses()) + " misses, capacity " +
+                                 std::to_string(caches[i]->getCapacity()) + " blocks");
     }
 }
 
@@ -381,6 +371,5 @@ void NodeManager::setIndexKeySize(unsigned long newIndexKeySize) {
 
     this->INDEX_KEY_SIZE = newIndexKeySize;
 }
-unsigned int NodeManager::nextPropertyIndex = 0;
 std::string NodeManager::NODE_DB_PATH = "/home/sandaruwan/ubuntu/software/jasminegraph/streamStore/g{}_p{}.db";
 const std::string NodeManager::FILE_MODE = "app";  // for appending to existing DB
@@ -11,11 +11,14 @@ See the License for the specific language governing permissions and
 limitations under the License.
 **/
 
+#include <atomic>
 #include <fstream>
+#include <mutex>
 #include <string>
-#include <unordered_map>
 
 #include "NodeBlock.h"
+#include "NodeIndex.h"
+#include "StoreHandles.h"
 
 #ifndef NODE_MANAGER
 #define NODE_MANAGER
@@ -29,33 +32,40 @@ struct GraphConfig {
 
 class NodeManager {
    private:
-    unsigned int nextNodeIndex = 0;
+    std::atomic<unsigned int> nextNodeIndex{0};
     std::fstream* nodeDBT;
     unsigned int graphID = 0;
     unsigned int partitionID = 0;
     static const std::string FILE_MODE;
+    static const unsigned long DEFAULT_BLOCK_CACHE_MB = 64;
     unsigned long INDEX_KEY_SIZE = 6;  // Size of an index key entry in bytes
+    StoreHandles store;                // Database files of this graph partition
 
-    int dbSize(std::string path);
-    void persistNodeIndex();
-    std::unordered_map<std::string, unsigned int> readNodeIndex();
+    // Striped per node locks held while a relation is spliced into the relation lists of its two end nodes
+    static const unsigned int NODE_LOCK_STRIPES = 1024;
+    std::mutex nodeLocks[NODE_LOCK_STRIPES];
+
+    unsigned long blockCacheBudget();
+    void logCacheStats();
+    std::mutex &nodeLock(NodeBlock &node) {
+        return nodeLocks[(node.addr / NodeBlock::BLOCK_SIZE) % NODE_LOCK_STRIPES];
+    };
+    NodeBlock *readNode(std::string nodeId, unsigned int blockIndex);
     static std::string NODE_DB_PATH;  // Node database file path
                                       // TODO(tmkasun): This NODE_DB_PATH should be moved to NodeBlock header definition
 
    public:
-    static unsigned int nextPropertyIndex;  // Next available property block index
-    // unless open in wipe data
-    // mode(trunc) need to set this value to property db seekp()/BLOCK_SIZE
     std::string index_db_loc;
 
-    std::unordered_map<std::string, unsigned int> nodeIndex;
+    NodeIndex nodeIndex;
 
     NodeManager(GraphConfig);
-    ~NodeManager() { delete NodeBlock::nodesDB; };
+    ~NodeManager();
     void setIndexKeySize(unsigned long);
     RelationBlock* addEdge(std::pair<std::string, std::string>);
     RelationBlock* addRelation(NodeBlock, NodeBlock);
     void close();
+    void checkpoint();
     NodeBlock* addNode(std::string);  // will redurn DB block address
     NodeBlock* get(std::string);
     std::list<NodeBlock> getGraph(int limit = 10);
@@ -9,47 +9,27 @@
 
 #include "../util/logger/Logger.h"
 Logger property_edge_link_logger;
-unsigned int PropertyEdgeLink::nextPropertyIndex = 1;  // Starting with 1 because of the 0 and '\0' differentiation issue
 std::string PropertyEdgeLink::DB_PATH = "/home/sandaruwan/ubuntu/software/jasminegraph/streamStore/properties.db";
-std::fstream* PropertyEdgeLink::edgePropertiesDB = NULL;
-pthread_mutex_t lockPropertyEdgeLink;
-pthread_mutex_t lockCreatePropertyEdgeLink;
-pthread_mutex_t lockInsertPropertyEdgeLink;
-pthread_mutex_t lockGetPropertyEdgeLink;
 
-
-
-
-
-PropertyEdgeLink::PropertyEdgeLink(unsigned int propertyBlockAddress) : blockAddress(propertyBlockAddress) {
-    pthread_mutex_lock(&lockPropertyEdgeLink);
+PropertyEdgeLink::PropertyEdgeLink(StoreHandles* store, unsigned int propertyBlockAddress)
+    : store(store), blockAddress(propertyBlockAddress) {
     if (propertyBlockAddress > 0) {
-        this->edgePropertiesDB->seekg(propertyBlockAddress);
-        char rawName[PropertyEdgeLink::MAX_NAME_SIZE] = {0};
-//        property_edge_link_logger.info("Traverse state  = " + std::to_string(PropertyEdgeLink::edgePropertiesDB->rdstate()));
-
-        if (!this->edgePropertiesDB->read(reinterpret_cast<char*>(&rawName), PropertyEdgeLink::MAX_NAME_SIZE)) {
-            property_edge_link_logger.error("Error while reading property name from block " + std::to_string(blockAddress));
+        PropertyRecord record;
+        if (!this->store->edgePropertiesDB->read(propertyBlockAddress, &record, sizeof(record))) {
+            property_edge_link_logger.error("Error while reading property block " + std::to_string(blockAddress));
+        } else {
+            char rawName[PropertyEdgeLink::MAX_NAME_SIZE + 1] = {0};
+            std::memcpy(rawName, record.name, PropertyEdgeLink::MAX_NAME_SIZE);
+            std::memcpy(this->value, record.value, PropertyEdgeLink::MAX_VALUE_SIZE);
+            this->nextPropAddress = record.next;
+            this->name = std::string(rawName);
         }
-        property_edge_link_logger.debug(
-                "Current file descriptor curser position = " + std::to_string(this->edgePropertiesDB->tellg()) +
-                " when reading = " + std::to_string(blockAddress));
-        if (!this->edgePropertiesDB->read(reinterpret_cast<char*>(&this->value), PropertyEdgeLink::MAX_VALUE_SIZE)) {
-            property_edge_link_logger.error("Error while reading property value from block " + std::to_string(blockAddress));
-        }
-
-        if (!this->edgePropertiesDB->read(reinterpret_cast<char*>(&(this->nextPropAddress)), sizeof(unsigned int))) {
-            property_edge_link_logger.error("Error while reading property next address from block " +
-                                       std::to_string(blockAddress));
-        }
-
-        this->name = std::string(rawName);
     }
-    pthread_mutex_unlock(&lockPropertyEdgeLink);
 };
 
-PropertyEdgeLink::PropertyEdgeLink(unsigned int blockAddress, std::string name, char* rvalue, unsigned int nextAddress)
-        : blockAddress(blockAddress), nextPropAddress(nextAddress), name(name) {
+PropertyEdgeLink::PropertyEdgeLink(StoreHandles* store, unsigned int blockAddress, std::string name, char* rvalue,
+                                   unsigned int nextAddress)
+        : store(store), name(name), blockAddress(blockAddress), nextPropAddress(nextAddress) {
     // Can't use just string copyer here because of binary data formats
     for (size_t i = 0; i < PropertyEdgeLink::MAX_VALUE_SIZE; i++) {
         this->value[i] = rvalue[i];
@@ -80,12 +60,6 @@ PropertyEdgeLink::PropertyEdgeLink(unsigned int blockAddress, std::string name,
  * **/
 unsigned int PropertyEdgeLink::insert(std::string name, char* value) {
 
-    char dataName[PropertyEdgeLink::MAX_NAME_SIZE] = {0};
-    char dataValue[PropertyEdgeLink::MAX_VALUE_SIZE] = {0};
-    std::strcpy(dataName, name.c_str());
-    std::memcpy(dataValue, value,
-                PropertyEdgeLink::MAX_VALUE_SIZE);  // strcpy or strncpy get terminated at null-character hence using memcpy
-
 //    property_edge_link_logger.debug("Received name = " + name);
 //    property_edge_link_logger.debug("Received value = " + std::string(value));
     unsigned int nextAddress = 0;
@@ -93,7 +67,6 @@ unsigned int PropertyEdgeLink::insert(std::string name, char* value) {
 //    property_edge_link_logger.info("current property name  = " + (this->name));
 //    property_edge_link_logger.info("new property name  = " + (name));
 
-
     if (this->name == name) {
         // TODO[tmkasun]: update existing property value
         property_edge_link_logger.warn("Property key/name already exist key = " + std::string(name));
@@ -103,30 +76,25 @@ unsigned int PropertyEdgeLink::insert(std::string name, char* value) {
     } else {  // No next link means end of the link, Now add the new link
 //        property_edge_link_logger.debug("Next prop index = " + std::to_string(PropertyEdgeLink::nextPropertyIndex));
 
-        pthread_mutex_lock(&lockInsertPropertyEdgeLink);
-        unsigned int newAddress = PropertyEdgeLink::nextPropertyIndex * PropertyEdgeLink::PROPERTY_BLOCK_SIZE;
-        this->edgePropertiesDB->seekp(newAddress);
-        this->edgePropertiesDB->write(dataName, PropertyEdgeLink::MAX_NAME_SIZE);
-        this->edgePropertiesDB->write(reinterpret_cast<char*>(dataValue), PropertyEdgeLink::MAX_VALUE_SIZE);
-        if (!this->edgePropertiesDB->write(reinterpret_cast<char*>(&nextAddress), sizeof(nextAddress))) {
+        pthread_mutex_lock(&this->store->propertyLock);
+        unsigned int newAddress = this->store->nextEdgePropertyIndex * PropertyEdgeLink::PROPERTY_BLOCK_SIZE;
+        PropertyRecord record = PropertyEdgeLink::toRecord(name, value, nextAddress);
+        if (!this->store->edgePropertiesDB->write(newAddress, &record, sizeof(record))) {
             property_edge_link_logger.error("Error while inserting a property " + name + " into block address " +
                                        std::to_string(newAddress));
+            pthread_mutex_unlock(&this->store->propertyLock);
             return -1;
         }
-
-        this->edgePropertiesDB->flush();
+        this->store->nextEdgePropertyIndex++;  // Increment the shared property index value
+        pthread_mutex_unlock(&this->store->propertyLock);
 
         this->nextPropAddress = newAddress;
-        this->edgePropertiesDB->seekp(this->blockAddress + PropertyEdgeLink::MAX_NAME_SIZE +
-                                  PropertyEdgeLink::MAX_VALUE_SIZE);  // seek to current property next address
-        if (!this->edgePropertiesDB->write(reinterpret_cast<char*>(&newAddress), sizeof(newAddress))) {
+        if (!this->store->edgePropertiesDB->write(this->blockAddress + offsetof(PropertyRecord, next), &newAddress,
+                                    sizeof(newAddress))) {  // current property next address
             property_edge_link_logger.error("Error while updating  property next address for " + name +
                                        " into block address " + std::to_string(this->blockAddress));
             return -1;
         }
-//        property_edge_link_logger.info("nextPropertyIndex = " + std::to_string(PropertyEdgeLink::nextPropertyIndex));
-        PropertyEdgeLink::nextPropertyIndex++;  // Increment the shared property index value
-        pthread_mutex_unlock(&lockInsertPropertyEdgeLink);
         return this->blockAddress;
 
     }
@@ -137,27 +105,20 @@ unsigned int PropertyEdgeLink::insert(std::string name, char* value) {
  * Create a brand new property link to an empty node block
  *
  * */
-PropertyEdgeLink* PropertyEdgeLink::create(std::string name, char value[]) {
-
-    pthread_mutex_lock(&lockCreatePropertyEdgeLink);
+PropertyEdgeLink* PropertyEdgeLink::create(StoreHandles* store, std::string name, char value[]) {
     unsigned int nextAddress = 0;
-    char dataName[PropertyEdgeLink::MAX_NAME_SIZE] = {0};
-    strcpy(dataName, name.c_str());
-    unsigned int newAddress = PropertyEdgeLink::nextPropertyIndex * PropertyEdgeLink::PROPERTY_BLOCK_SIZE;
-    PropertyEdgeLink::edgePropertiesDB->seekp(newAddress);
-    PropertyEdgeLink::edgePropertiesDB->write(dataName, PropertyEdgeLink::MAX_NAME_SIZE);
-    PropertyEdgeLink::edgePropertiesDB->write(reinterpret_cast<char*>(value), PropertyEdgeLink::MAX_VALUE_SIZE);
-    if (!PropertyEdgeLink::edgePropertiesDB->write(reinterpret_cast<char*>(&nextAddress), sizeof(nextAddress))) {
+    pthread_mutex_lock(&store->propertyLock);
+    unsigned int newAddress = store->nextEdgePropertyIndex * PropertyEdgeLink::PROPERTY_BLOCK_SIZE;
+    PropertyRecord record = PropertyEdgeLink::toRecord(name, value, nextAddress);
+    if (!store->edgePropertiesDB->write(newAddress, &record, sizeof(record))) {
         property_edge_link_logger.error("Error while inserting the property = " + name +
                                    " into block a new address = " + std::to_string(newAddress));
+        pthread_mutex_unlock(&store->propertyLock);
         return NULL;
     }
-    PropertyEdgeLink::edgePropertiesDB->flush();
-//    property_edge_link_logger.info("nextPropertyIndex = " + std::to_string(PropertyEdgeLink::nextPropertyIndex));
-//    property_edge_link_logger.info("newAddress = " + std::to_string(newAddress));
-    PropertyEdgeLink::nextPropertyIndex++;  // Increment the shared property index value
-    pthread_mutex_unlock(&lockCreatePropertyEdgeLink);
-    return new PropertyEdgeLink(newAddress, name, value, nextAddress);
+    store->nextEdgePropertyIndex++;  // Increment the shared property index value
+    pthread_mutex_unlock(&store->propertyLock);
+    return new PropertyEdgeLink(store, newAddress, name, value, nextAddress);
 }
 
 /**
@@ -165,48 +126,36 @@ PropertyEdgeLink* PropertyEdgeLink::create(std::string name, char value[]) {
  * */
 PropertyEdgeLink* PropertyEdgeLink::next() {
     if (this->nextPropAddress) {
-        return new PropertyEdgeLink(this->nextPropAddress);
+        return new PropertyEdgeLink(this->store, this->nextPropAddress);
     }
     return NULL;
 }
 
+PropertyRecord PropertyEdgeLink::toRecord(std::string name, char* value, unsigned int nextAddress) {
+    PropertyRecord record = {};
+    std::strncpy(record.name, name.c_str(), PropertyEdgeLink::MAX_NAME_SIZE);
+    // strcpy or strncpy get terminated at null-character hence using memcpy
+    std::memcpy(record.value, value, PropertyEdgeLink::MAX_VALUE_SIZE);
+    record.next = nextAddress;
+    return record;
+}
+
 bool PropertyEdgeLink::isEmpty() { return !(this->blockAddress); }
 
-PropertyEdgeLink* PropertyEdgeLink::get(unsigned int propertyBlockAddress) {
+PropertyEdgeLink* PropertyEdgeLink::get(StoreHandles* store, unsigned int propertyBlockAddress) {
     PropertyEdgeLink* pl = NULL;
 
-    pthread_mutex_lock(&lockGetPropertyEdgeLink);
     if (propertyBlockAddress > 0) {
-        char propertyName[PropertyEdgeLink::MAX_NAME_SIZE] = {0};
-        char propertyValue[PropertyEdgeLink::MAX_VALUE_SIZE] = {0};
-        unsigned int nextAddress;
-        PropertyEdgeLink::edgePropertiesDB->seekg(propertyBlockAddress);
-
-//        property_edge_link_logger.info("Searching propertyHead state  = " + std::to_string(PropertyEdgeLink::edgePropertiesDB->rdstate()));
-//        std::cout << "Stream state: " << PropertyEdgeLink::edgePropertiesDB->rdstate() << std::endl;
-//        std::string  PropertyEdgeLink::edgePropertiesDB->rdstate();
-        if (!PropertyEdgeLink::edgePropertiesDB->read(reinterpret_cast<char*>(&propertyName), PropertyEdgeLink::MAX_NAME_SIZE)) {
-//            property_edge_link_logger.error("Error  = " +
-//                                       std::to_string(PropertyEdgeLink::edgePropertiesDB->rdstate()));
-            property_edge_link_logger.error("Error while reading edge property name from block = " +
-                                       std::to_string(propertyBlockAddress));
+        PropertyRecord record;
+        char propertyName[PropertyEdgeLink::MAX_NAME_SIZE + 1] = {0};
+        if (!store->edgePropertiesDB->read(propertyBlockAddress, &record, sizeof(record))) {
+            property_edge_link_logger.error("Error while reading edge property block = " +
+                                            std::to_string(propertyBlockAddress));
+        } else {
+            std::memcpy(propertyName, record.name, PropertyEdgeLink::MAX_NAME_SIZE);
+            pl = new PropertyEdgeLink(store, propertyBlockAddress, std::string(propertyName), record.value, record.next);
         }
-        if (!PropertyEdgeLink::edgePropertiesDB->read(reinterpret_cast<char*>(&propertyValue), PropertyEdgeLink::MAX_VALUE_SIZE)) {
-            property_edge_link_logger.error("Error while reading edge property value from block = " +
-                                       std::to_string(propertyBlockAddress));
-        }
-
-        if (!PropertyEdgeLink::edgePropertiesDB->read(reinterpret_cast<char*>(&(nextAddress)), sizeof(unsigned int))) {
-            property_edge_link_logger.error("Error while reading edge property next address from block = " +
-                                       std::to_string(propertyBlockAddress));
-        }
-        property_edge_link_logger.info("Property head propertyBlockAddress  = " + std::to_string(propertyBlockAddress));
-        property_edge_link_logger.info("Property head property name  = " + std::string(propertyName));
-        property_edge_link_logger.info("Property head nextAddress   = " + std::to_string(nextAddress));
-
-        pl = new PropertyEdgeLink(propertyBlockAddress, std::string(propertyName), propertyValue, nextAddress);
     }
-    pthread_mutex_unlock(&lockGetPropertyEdgeLink);
     return pl;
 }
 
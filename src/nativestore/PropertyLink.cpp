@@ -20,47 +20,27 @@ limitations under the License.
 #include "../util/logger/Logger.h"
 
 Logger property_link_logger;
-unsigned int PropertyLink::nextPropertyIndex = 1;  // Starting with 1 because of the 0 and '\0' differentiation issue
 std::string PropertyLink::DB_PATH = "/home/sandaruwan/ubuntu/software/jasminegraph/streamStore/properties.db";
-std::fstream* PropertyLink::propertiesDB = NULL;
-pthread_mutex_t lockPropertyLink;
-pthread_mutex_t lockCreatePropertyLink;
-pthread_mutex_t lockInsertPropertyLink;
-pthread_mutex_t lockGetPropertyLink;
 
-
-
-
-
-PropertyLink::PropertyLink(unsigned int propertyBlockAddress) : blockAddress(propertyBlockAddress) {
-    pthread_mutex_lock(&lockPropertyLink);
+PropertyLink::PropertyLink(StoreHandles* store, unsigned int propertyBlockAddress)
+    : store(store), blockAddress(propertyBlockAddress) {
     if (propertyBlockAddress > 0) {
-        this->propertiesDB->seekg(propertyBlockAddress);
-        char rawName[PropertyLink::MAX_NAME_SIZE] = {0};
-//        property_link_logger.info("Traverse state  = " + std::to_string(PropertyLink::propertiesDB->rdstate()));
-
-        if (!this->propertiesDB->read(reinterpret_cast<char*>(&rawName), PropertyLink::MAX_NAME_SIZE)) {
-            property_link_logger.error("Error while reading node property name from block " + std::to_string(blockAddress));
-        }
-        property_link_logger.debug(
-            "Current file descriptor curser position = " + std::to_string(this->propertiesDB->tellg()) +
-            " when reading = " + std::to_string(blockAddress));
-        if (!this->propertiesDB->read(reinterpret_cast<char*>(&this->value), PropertyLink::MAX_VALUE_SIZE)) {
-            property_link_logger.error("Error while reading node property value from block " + std::to_string(blockAddress));
+        PropertyRecord record;
+        if (!this->store->propertiesDB->read(propertyBlockAddress, &record, sizeof(record))) {
+            property_link_logger.error("Error while reading node property block " + std::to_string(blockAddress));
+        } else {
+            char rawName[PropertyLink::MAX_NAME_SIZE + 1] = {0};
+            std::memcpy(rawName, record.name, PropertyLink::MAX_NAME_SIZE);
+            std::memcpy(this->value, record.value, PropertyLink::MAX_VALUE_SIZE);
+            this->nextPropAddress = record.next;
+            this->name = std::string(rawName);
         }
-
-        if (!this->propertiesDB->read(reinterpret_cast<char*>(&(this->nextPropAddress)), sizeof(unsigned int))) {
-            property_link_logger.error("Error while reading node property next address from block " +
-                                       std::to_string(blockAddress));
-        }
-
-        this->name = std::string(rawName);
     }
-    pthread_mutex_unlock(&lockPropertyLink);
 };
 
-PropertyLink::PropertyLink(unsigned int blockAddress, std::string name, char* rvalue, unsigned int nextAddress)
-    : blockAddress(blockAddress), nextPropAddress(nextAddress), name(name) {
+PropertyLink::PropertyLink(StoreHandles* store, unsigned int blockAddress, std::string name, char* rvalue,
+                           unsigned int nextAddress)
+    : store(store), name(name), blockAddress(blockAddress), nextPropAddress(nextAddress) {
     // Can't use just string copyer here because of binary data formats
     for (size_t i = 0; i < PropertyLink::MAX_VALUE_SIZE; i++) {
         this->value[i] = rvalue[i];
@@ -91,12 +71,6 @@ PropertyLink::PropertyLink(unsigned int blockAddress, std::string name, char* rv
  * **/
 unsigned int PropertyLink::insert(std::string name, char* value) {
 
-    char dataName[PropertyLink::MAX_NAME_SIZE] = {0};
-    char dataValue[PropertyLink::MAX_VALUE_SIZE] = {0};
-    std::strcpy(dataName, name.c_str());
-    std::memcpy(dataValue, value,
-                PropertyLink::MAX_VALUE_SIZE);  // strcpy or strncpy get terminated at null-character hence using memcpy
-
 //    property_link_logger.debug("Received name = " + name);
 //    property_link_logger.debug("Received value = " + std::string(value));
     unsigned int nextAddress = 0;
@@ -104,7 +78,6 @@ unsigned int PropertyLink::insert(std::string name, char* value) {
 //    property_link_logger.info("current property name  = " + (this->name));
 //    property_link_logger.info("new property name  = " + (name));
 
-
     if (this->name == name) {
         // TODO[tmkasun]: update existing property value
         property_link_logger.warn("Property key/name already exist key = " + std::string(name));
@@ -114,30 +87,25 @@ unsigned int PropertyLink::insert(std::string name, char* value) {
     } else {  // No next link means end of the link, Now add the new link
 //        property_link_logger.debug("Next prop index = " + std::to_string(PropertyLink::nextPropertyIndex));
 
-//        pthread_mutex_lock(&lockInsertPropertyLink);
-        unsigned int newAddress = PropertyLink::nextPropertyIndex * PropertyLink::PROPERTY_BLOCK_SIZE;
-        this->propertiesDB->seekp(newAddress);
-        this->propertiesDB->write(dataName, PropertyLink::MAX_NAME_SIZE);
-        this->propertiesDB->write(reinterpret_cast<char*>(dataValue), PropertyLink::MAX_VALUE_SIZE);
-        if (!this->propertiesDB->write(reinterpret_cast<char*>(&nextAddress), sizeof(nextAddress))) {
+        pthread_mutex_lock(&this->store->propertyLock);
+        unsigned int newAddress = this->store->nextPropertyIndex * PropertyLink::PROPERTY_BLOCK_SIZE;
+        PropertyRecord record = PropertyLink::toRecord(name, value, nextAddress);
+        if (!this->store->propertiesDB->write(newAddress, &record, sizeof(record))) {
             property_link_logger.error("Error while inserting a property " + name + " into block address " +
                                        std::to_string(newAddress));
+            pthread_mutex_unlock(&this->store->propertyLock);
             return -1;
         }
-
-        this->propertiesDB->flush();
+        this->store->nextPropertyIndex++;  // Increment the shared property index value
+        pthread_mutex_unlock(&this->store->propertyLock);
 
         this->nextPropAddress = newAddress;
-        this->propertiesDB->seekp(this->blockAddress + PropertyLink::MAX_NAME_SIZE +
-                                  PropertyLink::MAX_VALUE_SIZE);  // seek to current property next address
-        if (!this->propertiesDB->write(reinterpret_cast<char*>(&newAddress), sizeof(newAddress))) {
+        if (!this->store->propertiesDB->write(this->blockAddress + offsetof(PropertyRecord, next), &newAddress,
+                                    sizeof(newAddress))) {  // current property next address
             property_link_logger.error("Error while updating  property next address for " + name +
                                        " into block address " + std::to_string(this->blockAddress));
             return -1;
         }
-//        property_link_logger.info("nextPropertyIndex = " + std::to_string(PropertyLink::nextPropertyIndex));
-        PropertyLink::nextPropertyIndex++;  // Increment the shared property index value
-//        pthread_mutex_unlock(&lockInsertPropertyLink);
         return this->blockAddress;
 
     }
@@ -148,27 +116,20 @@ unsigned int PropertyLink::insert(std::string name, char* value) {
  * Create a brand new property link to an empty node block
  *
  * */
-PropertyLink* PropertyLink::create(std::string name, char value[]) {
-
-//    pthread_mutex_lock(&lockCreatePropertyLink);
+PropertyLink* PropertyLink::create(StoreHandles* store, std::string name, char value[]) {
     unsigned int nextAddress = 0;
-    char dataName[PropertyLink::MAX_NAME_SIZE] = {0};
-    strcpy(dataName, name.c_str());
-    unsigned int newAddress = PropertyLink::nextPropertyIndex * PropertyLink::PROPERTY_BLOCK_SIZE;
-    PropertyLink::propertiesDB->seekp(newAddress);
-    PropertyLink::propertiesDB->write(dataName, PropertyLink::MAX_NAME_SIZE);
-    PropertyLink::propertiesDB->write(reinterpret_cast<char*>(value), PropertyLink::MAX_VALUE_SIZE);
-    if (!PropertyLink::propertiesDB->write(reinterpret_cast<char*>(&nextAddress), sizeof(nextAddress))) {
+    pthread_mutex_lock(&store->propertyLock);
+    unsigned int newAddress = store->nextPropertyIndex * PropertyLink::PROPERTY_BLOCK_SIZE;
+    PropertyRecord record = PropertyLink::toRecord(name, value, nextAddress);
+    if (!store->propertiesDB->write(newAddress, &record, sizeof(record))) {
         property_link_logger.error("Error while inserting the property = " + name +
                                    " into block a new address = " + std::to_string(newAddress));
+        pthread_mutex_unlock(&store->propertyLock);
         return NULL;
     }
-    PropertyLink::propertiesDB->flush();
-//    property_link_logger.info("nextPropertyIndex = " + std::to_string(PropertyLink::nextPropertyIndex));
-//    property_link_logger.info("newAddress = " + std::to_string(newAddress));
-    PropertyLink::nextPropertyIndex++;  // Increment the shared property index value
-//    pthread_mutex_unlock(&lockCreatePropertyLink);
-    return new PropertyLink(newAddress, name, value, nextAddress);
+    store->nextPropertyIndex++;  // Increment the shared property index value
+    pthread_mutex_unlock(&store->propertyLock);
+    return new PropertyLink(store, newAddress, name, value, nextAddress);
 }
 
 /**
@@ -176,48 +137,36 @@ PropertyLink* PropertyLink::create(std::string name, char value[]) {
  * */
 PropertyLink* PropertyLink::next() {
     if (this->nextPropAddress) {
-        return new PropertyLink(this->nextPropAddress);
+        return new PropertyLink(this->store, this->nextPropAddress);
     }
     return NULL;
 }
 
+PropertyRecord PropertyLink::toRecord(std::string name, char* value, unsigned int nextAddress) {
+    PropertyRecord record = {};
+    std::strncpy(record.name, name.c_str(), PropertyLink::MAX_NAME_SIZE);
+    // strcpy or strncpy get terminated at null-character hence using memcpy
+    std::memcpy(record.value, value, PropertyLink::MAX_VALUE_SIZE);
+    record.next = nextAddress;
+    return record;
+}
+
 bool PropertyLink::isEmpty() { return !(this->blockAddress); }
 
-PropertyLink* PropertyLink::get(unsigned int propertyBlockAddress) {
+PropertyLink* PropertyLink::get(StoreHandles* store, unsigned int propertyBlockAddress) {
     PropertyLink* pl = NULL;
 
-//    pthread_mutex_lock(&lockGetPropertyLink);
     if (propertyBlockAddress > 0) {
-        char propertyName[PropertyLink::MAX_NAME_SIZE] = {0};
-        char propertyValue[PropertyLink::MAX_VALUE_SIZE] = {0};
-        unsigned int nextAddress;
-        PropertyLink::propertiesDB->seekg(propertyBlockAddress);
-
-//        property_link_logger.info("Searching propertyHead state  = " + std::to_string(PropertyLink::propertiesDB->rdstate()));
-//        std::cout << "Stream state: " << PropertyLink::propertiesDB->rdstate() << std::endl;
-//        std::string  PropertyLink::propertiesDB->rdstate();
-        if (!PropertyLink::propertiesDB->read(reinterpret_cast<char*>(&propertyName), PropertyLink::MAX_NAME_SIZE)) {
-//            property_link_logger.error("Error  = " +
-//                                       std::to_string(PropertyLink::propertiesDB->rdstate()));
-            property_link_logger.error("Error while reading node property name from block = " +
-                                       std::to_string(propertyBlockAddress));
-        }
-        if (!PropertyLink::propertiesDB->read(reinterpret_cast<char*>(&propertyValue), PropertyLink::MAX_VALUE_SIZE)) {
-            property_link_logger.error("Error while reading node property value from block = " +
+        PropertyRecord record;
+        char propertyName[PropertyLink::MAX_NAME_SIZE + 1] = {0};
+        if (!store->propertiesDB->read(propertyBlockAddress, &record, sizeof(record))) {
+            property_link_logger.error("Error while reading node property block = " +
                                        std::to_string(propertyBlockAddress));
+        } else {
+            std::memcpy(propertyName, record.name, PropertyLink::MAX_NAME_SIZE);
+            pl = new PropertyLink(store, propertyBlockAddress, std::string(propertyName), record.value, record.next);
         }
-
-        if (!PropertyLink::propertiesDB->read(reinterpret_cast<char*>(&(nextAddress)), sizeof(unsigned int))) {
-            property_link_logger.error("Error while reading node property next address from block = " +
-                                       std::to_string(propertyBlockAddress));
-        }
-//        property_link_logger.info("Property head propertyBlockAddress  = " + std::to_string(propertyBlockAddress));
-//        property_link_logger.info("Property head property name  = " + std::string(propertyName));
-//        property_link_logger.info("Property head nextAddress   = " + std::to_string(nextAddress));
-
-        pl = new PropertyLink(propertyBlockAddress, std::string(propertyName), propertyValue, nextAddress);
     }
-//    pthread_mutex_unlock(&lockGetPropertyLink);
     return pl;
 }
 
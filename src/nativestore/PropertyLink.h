@@ -11,11 +11,15 @@ See the License for the specific language governing permissions and
 limitations under the License.
 **/
 
+#include <cstddef>
 #include <cstring>
 #include <fstream>
 #include <set>
 #include <string>
 
+#include "BlockRecords.h"
+#include "StoreHandles.h"
+
 #ifndef PROPERTY_LINK
 #define PROPERTY_LINK
 
@@ -23,26 +27,24 @@ class PropertyLink {
    public:
     static const unsigned long MAX_NAME_SIZE = 12;    // Size of a property name in bytes
     static const unsigned long MAX_VALUE_SIZE = 180;  // Size of a property value in bytes
-    static unsigned int nextPropertyIndex;            // Next available property block index
-    // unless open in wipe data
-    // mode(trunc) need to set this value to property db seekp()/BLOCK_SIZE
     static const unsigned long PROPERTY_BLOCK_SIZE = MAX_NAME_SIZE + MAX_VALUE_SIZE + sizeof(unsigned int);
     
+    StoreHandles* store = NULL;  // Database files of the store this link belongs to
     std::string name;
     char value[PropertyLink::MAX_VALUE_SIZE] = {0};
     unsigned int blockAddress;  // contains the address of the first element in the list
     unsigned int nextPropAddress;
 
     static std::string DB_PATH;
-    static std::fstream* propertiesDB;
 
 
 
-    PropertyLink(unsigned int);
-    PropertyLink(unsigned int, std::string, char*, unsigned int);
+    PropertyLink(StoreHandles*, unsigned int);
+    PropertyLink(StoreHandles*, unsigned int, std::string, char*, unsigned int);
     bool isEmpty();
-    static PropertyLink* get(unsigned int);
-    static PropertyLink* create(std::string, char[]);
+    static PropertyLink* get(StoreHandles*, unsigned int);
+    static PropertyLink* create(StoreHandles*, std::string, char[]);
+    static PropertyRecord toRecord(std::string, char*, unsigned int);
 
     unsigned int insert(std::string, char[]);
     PropertyLink* next();
@@ -20,449 +20,139 @@ limitations under the License.
 #include "NodeManager.h"
 
 Logger relation_block_logger;
-pthread_mutex_t lockAddProperty;
 
 RelationBlock* RelationBlock::add(NodeBlock source, NodeBlock destination) {
-    int RECORD_SIZE = sizeof(unsigned int);
-
     NodeRelation sourceData;
     NodeRelation destinationData;
 
     sourceData.address = source.addr;
     destinationData.address = destination.addr;
 
-//    unsigned int relationPropAddr = this;
-
-    long relationBlockAddress = RelationBlock::nextRelationIndex * RelationBlock::BLOCK_SIZE;  // Block size is 4 * 13
-
-    RelationBlock::relationsDB->seekg(relationBlockAddress);
-    if (!RelationBlock::relationsDB->write(reinterpret_cast<char*>(&source.nodeId), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing  sourceAddr " +
-                                    std::to_string(source.nodeId) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
-        return NULL;
-    }
-    if (!RelationBlock::relationsDB->write(reinterpret_cast<char*>(&destination.nodeId), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing  destinationAddr " +
-                                    std::to_string(destination.nodeId) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
-        return NULL;
-    }
-    if (!RelationBlock::relationsDB->write(reinterpret_cast<char*>(&sourceData.address), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing relation destAddr " +
-                                    std::to_string(sourceData.address) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
-        return NULL;
-    }
-
-    if (!RelationBlock::relationsDB->write(reinterpret_cast<char*>(&destinationData.address), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing relation destAddr " +
-                                    std::to_string(destinationData.address) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
-        return NULL;
-    }
-
-    if (!RelationBlock::relationsDB->write(reinterpret_cast<char*>(&sourceData.nextRelationId), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing source next relation address " +
-                                    std::to_string(sourceData.nextRelationId) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
-        return NULL;
-    }
-
-    if (!RelationBlock::relationsDB->write(reinterpret_cast<char*>(&sourceData.nextPid), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing source next relation partition ID " +
-                                    std::to_string(sourceData.nextPid) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
-        return NULL;
-    }
-
-    if (!RelationBlock::relationsDB->write(reinterpret_cast<char*>(&sourceData.preRelationId), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing source previous relation address " +
-                                    std::to_string(sourceData.preRelationId) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
-        return NULL;
-    }
-
-    if (!RelationBlock::relationsDB->write(reinterpret_cast<char*>(&sourceData.prePid), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing source previous relation partition ID " +
-                                    std::to_string(sourceData.prePid) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
-        return NULL;
-    }
-
-    if (!RelationBlock::relationsDB->write(reinterpret_cast<char*>(&destinationData.nextRelationId), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing destination next relation address " +
-                                    std::to_string(destinationData.nextRelationId) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
-        return NULL;
-    }
-
-    if (!RelationBlock::relationsDB->write(reinterpret_cast<char*>(&destinationData.nextPid), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing destination next partition id " +
-                                    std::to_string(destinationData.nextPid) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
-        return NULL;
-    }
-
-    if (!RelationBlock::relationsDB->write(reinterpret_cast<char*>(&destinationData.preRelationId), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing destination previous relation address " +
-                                    std::to_string(destinationData.preRelationId) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
-        return NULL;
-    }
-
-    if (!RelationBlock::relationsDB->write(reinterpret_cast<char*>(&destinationData.prePid), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing destination previous relation partition id " +
-                                    std::to_string(destinationData.prePid) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
-        return NULL;
-    }
+    StoreHandles* store = source.store;
+    unsigned int relationPropAddr = 0;
 
-    if (!RelationBlock::relationsDB->write(reinterpret_cast<char*>(&(this->propertyAddress)), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing relation property address " +
-                                    std::to_string(this->propertyAddress) + " into relation block address " +
+    long relationBlockAddress = store->nextRelationIndex++ * RelationBlock::BLOCK_SIZE;  // Block size is 4 * 13
+    RelationRecord record = RelationBlock::toRecord(source.nodeId, destination.nodeId, sourceData, destinationData,
+                                                    relationPropAddr);
+    if (!store->relationsCache->write(relationBlockAddress, 0, &record, sizeof(record))) {
+        relation_block_logger.error("ERROR: Error while writing relation between " + std::to_string(source.nodeId) +
+                                    " and " + std::to_string(destination.nodeId) + " into relation block address " +
                                     std::to_string(relationBlockAddress));
         return NULL;
     }
 
-    RelationBlock::nextRelationIndex += 1;
-    RelationBlock::relationsDB->flush();
-    return new RelationBlock(relationBlockAddress, sourceData, destinationData, this->propertyAddress);
+    return new RelationBlock(store, relationBlockAddress, sourceData, destinationData, relationPropAddr);
 }
 
 RelationBlock* RelationBlock::addCentral(NodeBlock source, NodeBlock destination) {
-    int RECORD_SIZE = sizeof(unsigned int);
-
     NodeRelation sourceData;
     NodeRelation destinationData;
 
     sourceData.address = source.addr;
     destinationData.address = destination.addr;
 
+    StoreHandles* store = source.store;
     unsigned int relationPropAddr = 0;
 
-    long relationBlockAddress = RelationBlock::nextCentralRelationIndex * RelationBlock::BLOCK_SIZE;  // Block size is 4 * 11
-    RelationBlock::centralrelationsDB->seekg(relationBlockAddress);
-    if (!RelationBlock::centralrelationsDB->write(reinterpret_cast<char*>(&source.nodeId), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing  sourceAddr " +
-                                    std::to_string(source.nodeId) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
-        return NULL;
-    }
-    if (!RelationBlock::centralrelationsDB->write(reinterpret_cast<char*>(&destination.nodeId), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing  destinationAddr " +
-                                    std::to_string(destination.nodeId) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
-        return NULL;
-    }
-    if (!RelationBlock::centralrelationsDB->write(reinterpret_cast<char*>(&sourceData.address), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing relation destAddr " +
-                                    std::to_string(sourceData.address) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
+    long relationBlockAddress =
+        store->nextCentralRelationIndex++ * RelationBlock::BLOCK_SIZE;  // Block size is 4 * 13
+    RelationRecord record = RelationBlock::toRecord(source.nodeId, destination.nodeId, sourceData, destinationData,
+                                                    relationPropAddr);
+    if (!store->centralRelationsCache->write(relationBlockAddress, 0, &record, sizeof(record))) {
+        relation_block_logger.error("ERROR: Error while writing central relation between " +
+                                    std::to_string(source.nodeId) + " and " + std::to_string(destination.nodeId) +
+                                    " into relation block address " + std::to_string(relationBlockAddress));
         return NULL;
     }
 
-    if (!RelationBlock::centralrelationsDB->write(reinterpret_cast<char*>(&destinationData.address), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing relation destAddr " +
-                                    std::to_string(destinationData.address) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
-        return NULL;
-    }
-
-    if (!RelationBlock::centralrelationsDB->write(reinterpret_cast<char*>(&sourceData.nextRelationId), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing source next relation address " +
-                                    std::to_string(sourceData.nextRelationId) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
-        return NULL;
-    }
-
-    if (!RelationBlock::centralrelationsDB->write(reinterpret_cast<char*>(&sourceData.nextPid), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing source next relation partition ID " +
-                                    std::to_string(sourceData.nextPid) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
-        return NULL;
-    }
-
-    if (!RelationBlock::centralrelationsDB->write(reinterpret_cast<char*>(&sourceData.preRelationId), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing source previous relation address " +
-                                    std::to_string(sourceData.preRelationId) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
-        return NULL;
-    }
-
-    if (!RelationBlock::centralrelationsDB->write(reinterpret_cast<char*>(&sourceData.prePid), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing source previous relation partition ID " +
-                                    std::to_string(sourceData.prePid) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
-        return NULL;
-    }
-
-    if (!RelationBlock::centralrelationsDB->write(reinterpret_cast<char*>(&destinationData.nextRelationId), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing destination next relation address " +
-                                    std::to_string(destinationData.nextRelationId) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
-        return NULL;
-    }
-
-    if (!RelationBlock::centralrelationsDB->write(reinterpret_cast<char*>(&destinationData.nextPid), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing destination next partition id " +
-                                    std::to_string(destinationData.nextPid) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
-        return NULL;
-    }
-
-    if (!RelationBlock::centralrelationsDB->write(reinterpret_cast<char*>(&destinationData.preRelationId), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing destination previous relation address " +
-                                    std::to_string(destinationData.preRelationId) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
-        return NULL;
-    }
-
-    if (!RelationBlock::centralrelationsDB->write(reinterpret_cast<char*>(&destinationData.prePid), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing destination previous relation partition id " +
-                                    std::to_string(destinationData.prePid) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
-        return NULL;
-    }
-
-    if (!RelationBlock::centralrelationsDB->write(reinterpret_cast<char*>(&relationPropAddr), RECORD_SIZE)) {
-        relation_block_logger.error("ERROR: Error while writing relation property address " +
-                                    std::to_string(relationPropAddr) + " into relation block address " +
-                                    std::to_string(relationBlockAddress));
-        return NULL;
-    }
-
-    RelationBlock::nextCentralRelationIndex += 1;
-    RelationBlock::centralrelationsDB->flush();
-    return new RelationBlock(relationBlockAddress, sourceData, destinationData, relationPropAddr);
+    return new RelationBlock(store, relationBlockAddress, sourceData, destinationData, relationPropAddr);
 }
 
-RelationBlock* RelationBlock::get(unsigned int address) {
-    int RECORD_SIZE = sizeof(unsigned int);
-    if (address == 0) {
-        return NULL;
-    } else if (address % RelationBlock::BLOCK_SIZE != 0) {
-        throw "Exception: Invalid relation block address !!\n received address = " + address;
-    }
+RelationRecord RelationBlock::toRecord(unsigned int sourceId, unsigned int destinationId, NodeRelation source,
+                                       NodeRelation destination, unsigned int propertyAddress) {
+    RelationRecord record;
+    record.sourceId = sourceId;
+    record.destinationId = destinationId;
+    record.sourceAddress = source.address;
+    record.destinationAddress = destination.address;
+    record.sourceNext = source.nextRelationId;
+    record.sourceNextPid = source.nextPid;
+    record.sourcePrevious = source.preRelationId;
+    record.sourcePreviousPid = source.prePid;
+    record.destinationNext = destination.nextRelationId;
+    record.destinationNextPid = destination.nextPid;
+    record.destinationPrevious = destination.preRelationId;
+    record.destinationPreviousPid = destination.prePid;
+    record.propertyAddress = propertyAddress;
+    return record;
+}
 
-    RelationBlock::relationsDB->seekg(address + RECORD_SIZE*2);
+RelationBlock* RelationBlock::fromRecord(StoreHandles* store, unsigned int address, const RelationRecord& record) {
     NodeRelation source;
     NodeRelation destination;
-    unsigned int propertyReference;
-
-    RelationBlock::relationsDB->read(reinterpret_cast<char*>(&source.address),
-                                     RECORD_SIZE);  // < ------ relation data offset ID = 0
-    if (!RelationBlock::relationsDB->read(reinterpret_cast<char*>(&destination.address),
-                                          RECORD_SIZE)) {  // < ------ relation data offset ID = 1
-        relation_block_logger.error(
-            "Error while reading relation source node address offset ID = 1 from "
-            "relation block address " +
-            std::to_string(address));
-        return NULL;
-    }
-
-    if (!RelationBlock::relationsDB->read(reinterpret_cast<char*>(&source.nextRelationId),
-                                          RECORD_SIZE)) {  // < ------ relation data offset ID = 2
-        relation_block_logger.error(
-            "Error while reading relation source next relation address offset ID = 2 from "
-            "relation block address " +
-            std::to_string(address));
-        return NULL;
-    }
-
-    if (!RelationBlock::relationsDB->read(reinterpret_cast<char*>(&source.nextPid),
-                                          RECORD_SIZE)) {  // < ------ relation data offset ID = 3
-        relation_block_logger.error(
-            "Error while reading relation source next relation partition id offset ID = 3 from "
-            "relation block address " +
-            std::to_string(address));
-        return NULL;
-    }
-
-    if (!RelationBlock::relationsDB->read(reinterpret_cast<char*>(&source.preRelationId),
-                                          RECORD_SIZE)) {  // < ------ relation data offset ID = 4
-        relation_block_logger.error(
-            "Error while reading relation source previous relation address offset ID = 4 from "
-            "relation block address " +
-            std::to_string(address));
-        return NULL;
-    }
-
-    if (!RelationBlock::relationsDB->read(reinterpret_cast<char*>(&source.prePid),
-                                          RECORD_SIZE)) {  // < ------ relation data offset ID = 5
-        relation_block_logger.error(
-            "Error while reading relation source previous relation partition id offset ID = 5 from "
-            "relation block address " +
-            std::to_string(address));
-        return NULL;
-    }
-
-    if (!RelationBlock::relationsDB->read(reinterpret_cast<char*>(&destination.nextRelationId),
-                                          RECORD_SIZE)) {  // < ------ relation data offset ID = 6
-        relation_block_logger.error(
-            "Error while reading relation destination next relation address offset ID = 6 from "
-            "relation block address " +
-            std::to_string(address));
-        return NULL;
-    }
-
-    if (!RelationBlock::relationsDB->read(reinterpret_cast<char*>(&destination.nextPid),
-                                          RECORD_SIZE)) {  // < ------ relation data offset ID = 7
-        relation_block_logger.error(
-            "ERROR: Error while reading relation destination next relation partition id offset ID = 7 from "
-            "relation block address " +
-            std::to_string(address));
-        return NULL;
-    }
-
-    if (!RelationBlock::relationsDB->read(reinterpret_cast<char*>(&destination.preRelationId),
-                                          RECORD_SIZE)) {  // < ------ relation data offset ID = 8
-        relation_block_logger.error(
-            "ERROR: Error while reading relation destination previous relation address data offset ID = 8 from "
-            "relation block address " +
-            std::to_string(address));
-        return NULL;
-    }
-
-    if (!RelationBlock::relationsDB->read(reinterpret_cast<char*>(&destination.prePid),
-                                          RECORD_SIZE)) {  // < ------ relation data offset ID = 9
-        relation_block_logger.error(
-            "ERROR: Error while reading relation destination previous relation partition id data offset ID = 9 from "
-            "relation block address " +
-            std::to_string(address));
-        return NULL;
-    }
-
-    if (!RelationBlock::relationsDB->read(reinterpret_cast<char*>(&propertyReference),
-                                          RECORD_SIZE)) {  // < ------ relation data offset ID = 10
-        relation_block_logger.error(
-            "ERROR: Error while reading relation property address data offset ID = 10 from relation block address " +
-            std::to_string(address));
-        return NULL;
-    }
-
-    return new RelationBlock(address, source, destination, propertyReference);
+    source.address = record.sourceAddress;
+    source.nextRelationId = record.sourceNext;
+    source.nextPid = record.sourceNextPid;
+    source.preRelationId = record.sourcePrevious;
+    source.prePid = record.sourcePreviousPid;
+    destination.address = record.destinationAddress;
+    destination.nextRelationId = record.destinationNext;
+    destination.nextPid = record.destinationNextPid;
+    destination.preRelationId = record.destinationPrevious;
+    destination.prePid = record.destinationPreviousPid;
+    return new RelationBlock(store, address, source, destination, record.propertyAddress);
 }
 
-RelationBlock* RelationBlock::getCentral(unsigned int address) {
-    int RECORD_SIZE = sizeof(unsigned int);
+RelationBlock* RelationBlock::get(StoreHandles* store, unsigned int address) {
     if (address == 0) {
         return NULL;
     } else if (address % RelationBlock::BLOCK_SIZE != 0) {
-        throw "Exception: Invalid relation block address !!\n received address = " + address;
-    }
-
-    RelationBlock::centralrelationsDB->seekg(address + RECORD_SIZE*2);
-    NodeRelation source;
-    NodeRelation destination;
-    unsigned int propertyReference;
-
-    RelationBlock::centralrelationsDB->read(reinterpret_cast<char*>(&source.address),
-                                     RECORD_SIZE);  // < ------ relation data offset ID = 0
-    if (!RelationBlock::centralrelationsDB->read(reinterpret_cast<char*>(&destination.address),
-                                          RECORD_SIZE)) {  // < ------ relation data offset ID = 1
-        relation_block_logger.error(
-                "Error while reading relation source node address offset ID = 1 from "
-                "relation block address " +
-                std::to_string(address));
-        return NULL;
-    }
-
-    if (!RelationBlock::centralrelationsDB->read(reinterpret_cast<char*>(&source.nextRelationId),
-                                          RECORD_SIZE)) {  // < ------ relation data offset ID = 2
-        relation_block_logger.error(
-                "Error while reading relation source next relation address offset ID = 2 from "
-                "relation block address " +
-                std::to_string(address));
-        return NULL;
-    }
-
-    if (!RelationBlock::centralrelationsDB->read(reinterpret_cast<char*>(&source.nextPid),
-                                          RECORD_SIZE)) {  // < ------ relation data offset ID = 3
-        relation_block_logger.error(
-                "Error while reading relation source next relation partition id offset ID = 3 from "
-                "relation block address " +
-                std::to_string(address));
-        return NULL;
+        throw "Exception: Invalid relation block address !!\n received address = " + std::to_string(address);
     }
 
-    if (!RelationBlock::centralrelationsDB->read(reinterpret_cast<char*>(&source.preRelationId),
-                                          RECORD_SIZE)) {  // < ------ relation data offset ID = 4
-        relation_block_logger.error(
-                "Error while reading relation source previous relation address offset ID = 4 from "
-                "relation block address " +
-                std::to_string(address));
-        return NULL;
-    }
-
-    if (!RelationBlock::centralrelationsDB->read(reinterpret_cast<char*>(&source.prePid),
-                                          RECORD_SIZE)) {  // < ------ relation data offset ID = 5
-        relation_block_logger.error(
-                "Error while reading relation source previous relation partition id offset ID = 5 from "
-                "relation block address " +
-                std::to_string(address));
-        return NULL;
-    }
-
-    if (!RelationBlock::centralrelationsDB->read(reinterpret_cast<char*>(&destination.nextRelationId),
-                                          RECORD_SIZE)) {  // < ------ relation data offset ID = 6
-        relation_block_logger.error(
-                "Error while reading relation destination next relation address offset ID = 6 from "
-                "relation block address " +
-                std::to_string(address));
-        return NULL;
-    }
-
-    if (!RelationBlock::centralrelationsDB->read(reinterpret_cast<char*>(&destination.nextPid),
-                                          RECORD_SIZE)) {  // < ------ relation data offset ID = 7
-        relation_block_logger.error(
-                "ERROR: Error while reading relation destination next relation partition id offset ID = 7 from "
-                "relation block address " +
-                std::to_string(address));
-        return NULL;
-    }
-
-    if (!RelationBlock::centralrelationsDB->read(reinterpret_cast<char*>(&destination.preRelationId),
-                                          RECORD_SIZE)) {  // < ------ relation data offset ID = 8
-        relation_block_logger.error(
-                "ERROR: Error while reading relation destination previous relation address data offset ID = 8 from "
-                "relation block address " +
-                std::to_string(address));
+    RelationRecord record;
+    if (!store->relationsCache->read(address, &record)) {
+        relation_block_logger.error("Error while reading relation block address " + std::to_string(address));
         return NULL;
     }
+    return RelationBlock::fromRecord(store, address, record);
+}
 
-    if (!RelationBlock::centralrelationsDB->read(reinterpret_cast<char*>(&destination.prePid),
-                                          RECORD_SIZE)) {  // < ------ relation data offset ID = 9
-        relation_block_logger.error(
-                "ERROR: Error while reading relation destination previous relation partition id data offset ID = 9 from "
-                "relation block address " +
-                std::to_string(address));
+RelationBlock* RelationBlock::getCentral(StoreHandles* store, unsigned int address) {
+    if (address == 0) {
         return NULL;
+    } else if (address % RelationBlock::BLOCK_SIZE != 0) {
+        throw "Exception: Invalid relation block address !!\n received address = " + std::to_string(address);
     }
 
-    if (!RelationBlock::centralrelationsDB->read(reinterpret_cast<char*>(&propertyReference),
-                                          RECORD_SIZE)) {  // < ------ relation data offset ID = 10
-        relation_block_logger.error(
-                "ERROR: Error while reading relation property address data offset ID = 10 from relation block address " +
-                std::to_string(address));
+    RelationRecord record;
+    if (!store->centralRelationsCache->read(address, &record)) {
+        relation_block_logger.error("Error while reading central relation block address " + std::to_string(address));
         return NULL;
     }
-
-    return new RelationBlock(address, source, destination, propertyReference);
+    return RelationBlock::fromRecord(store, address, record);
 }
 
 
-RelationBlock* RelationBlock::nextSource() { return RelationBlock::get(this->source.nextRelationId); }
+RelationBlock* RelationBlock::nextSource() { return RelationBlock::get(this->store, this->source.nextRelationId); }
 
-RelationBlock* RelationBlock::nextCentralSource() { return RelationBlock::getCentral(this->source.nextRelationId); }
+RelationBlock* RelationBlock::nextCentralSource() {
+    return RelationBlock::getCentral(this->store, this->source.nextRelationId);
+}
 
-RelationBlock* RelationBlock::previousSource() { return RelationBlock::get(this->source.preRelationId); }
+RelationBlock* RelationBlock::previousSource() { return RelationBlock::get(this->store, this->source.preRelationId); }
 
-RelationBlock* RelationBlock::nextDestination() { return RelationBlock::get(this->destination.nextRelationId); }
+RelationBlock* RelationBlock::nextDestination() {
+    return RelationBlock::get(this->store, this->destination.nextRelationId);
+}
 
-RelationBlock* RelationBlock::nextCentralDestination() { return RelationBlock::getCentral(this->destination.nextRelationId); }
+RelationBlock* RelationBlock::nextCentralDestination() {
+    return RelationBlock::getCentral(this->store, this->destination.nextRelationId);
+}
 
-RelationBlock* RelationBlock::previousDestination() { return RelationBlock::get(this->destination.preRelationId); }
+RelationBlock* RelationBlock::previousDestination() {
+    return RelationBlock::get(this->store, this->destination.preRelationId);
+}
 
 bool RelationBlock::setNextSource(unsigned int newAddress) {
     if (this->updateRelationRecords(RelationOffsets::SOURCE_NEXT, newAddress)) {
@@ -553,39 +243,33 @@ bool RelationBlock::setCentralPreviousDestination(unsigned int newAddress) {
 bool RelationBlock::updateRelationRecords(RelationOffsets recordOffset, unsigned int data) {
     int offsetValue = static_cast<int>(recordOffset);
     int dataOffset = RECORD_SIZE * offsetValue;
-    RelationBlock::relationsDB->seekg(this->addr + dataOffset);
-    if (!RelationBlock::relationsDB->write(reinterpret_cast<char*>(&data), RECORD_SIZE)) {
+    if (!this->store->relationsCache->write(this->addr, dataOffset, &data, RECORD_SIZE)) {
         relation_block_logger.error("Error while updating relation data record offset " + std::to_string(offsetValue) +
                                     "data " + std::to_string(data));
         return false;
     }
-    RelationBlock::relationsDB->flush();
     return true;
 }
 
 bool RelationBlock::updateCentralRelationRecords(RelationOffsets recordOffset, unsigned int data) {
     int offsetValue = static_cast<int>(recordOffset);
     int dataOffset = RECORD_SIZE * offsetValue;
-    RelationBlock::centralrelationsDB->seekg(this->addr + dataOffset);
-    if (!RelationBlock::centralrelationsDB->write(reinterpret_cast<char*>(&data), RECORD_SIZE)) {
+    if (!this->store->centralRelationsCache->write(this->addr, dataOffset, &data, RECORD_SIZE)) {
         relation_block_logger.error("Error while updating relation data record offset " + std::to_string(offsetValue) +
                                     "data " + std::to_string(data));
         return false;
     }
-    RelationBlock::centralrelationsDB->flush();
     return true;
 }
 
 
 bool RelationBlock::isInUse() { return this->usage == '\1'; }
-unsigned int RelationBlock::nextRelationIndex = 1;  // Starting with 1 because of the 0 and '\0' differentiation issue
-unsigned int RelationBlock::nextCentralRelationIndex = 1;  // Starting with 1 because of the 0 and '\0' differentiation issue
 
 
 void RelationBlock::addProperty(std::string name, char* value) {
 
     if (this->propertyAddress == 0) {
-        PropertyEdgeLink* newLink = PropertyEdgeLink::create(name, value);
+        PropertyEdgeLink* newLink = PropertyEdgeLink::create(this->store, name, value);
         if (newLink) {
             this->propertyAddress = newLink->blockAddress;
             // If it was an empty prop link before inserting, Then update the property reference of this node
@@ -604,7 +288,7 @@ void RelationBlock::addProperty(std::string name, char* value) {
 }
 void RelationBlock::addCentralProperty(std::string name, char* value) {
     if (this->propertyAddress == 0) {
-        PropertyEdgeLink* newLink = PropertyEdgeLink::create(name, value);
+        PropertyEdgeLink* newLink = PropertyEdgeLink::create(this->store, name, value);
         if (newLink) {
             this->propertyAddress = newLink->blockAddress;
             // If it was an empty prop link before inserting, Then update the property reference of this node
@@ -619,7 +303,7 @@ void RelationBlock::addCentralProperty(std::string name, char* value) {
 }
 
 
-PropertyEdgeLink* RelationBlock::getPropertyHead() { return PropertyEdgeLink::get(this->propertyAddress); }
+PropertyEdgeLink* RelationBlock::getPropertyHead() { return PropertyEdgeLink::get(this->store, this->propertyAddress); }
 
 std::map<std::string, char*> RelationBlock::getAllProperties() {
     std::map<std::string, char*> allProperties;
@@ -660,9 +344,7 @@ NodeBlock* RelationBlock::getDestination() {
     }
 }
 
-const unsigned long RelationBlock::BLOCK_SIZE = RelationBlock::RECORD_SIZE * 13;
-// One relation block holds 11 recods such as source addres, destination address, source next relation address etc.
-// and one record is typically 4 bytes (size of unsigned int)
+const unsigned long RelationBlock::BLOCK_SIZE = sizeof(RelationRecord);
+// One relation block holds 13 records such as source addres, destination address, source next relation address etc.
+// and one record is typically 4 bytes (size of unsigned int). See RelationRecord for the exact layout
 std::string RelationBlock::DB_PATH = "/home/sandaruwan/ubuntu/software/jasminegraph/streamStore/relations.db";
-std::fstream* RelationBlock::relationsDB = NULL;
-std::fstream* RelationBlock::centralrelationsDB = NULL;
\ No newline at end of file
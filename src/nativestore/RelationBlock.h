@@ -59,20 +59,17 @@ class RelationBlock {
    private:
     std::string id;
     bool updateRelationRecords(RelationOffsets, unsigned int);
-    NodeBlock *sourceBlock;
-    NodeBlock *destinationBlock;
+    static RelationRecord toRecord(unsigned int, unsigned int, NodeRelation, NodeRelation, unsigned int);
+    static RelationBlock *fromRecord(StoreHandles *, unsigned int, const RelationRecord &);
+    NodeBlock *sourceBlock = NULL;
+    NodeBlock *destinationBlock = NULL;
 
    public:
-    RelationBlock(NodeBlock source, NodeBlock destination){
-        this->sourceBlock = &source;
-        this->destinationBlock = &destination;
-    }
-
-
-    RelationBlock(unsigned int addr, NodeRelation source, NodeRelation destination, unsigned int propertyAddress)
-        : addr(addr), source(source), destination(destination), propertyAddress(propertyAddress){};
-
+    RelationBlock(StoreHandles *store, unsigned int addr, NodeRelation source, NodeRelation destination,
+                  unsigned int propertyAddress)
+        : store(store), addr(addr), source(source), destination(destination), propertyAddress(propertyAddress){};
 
+    StoreHandles *store = NULL;  // Database files of the store this relation belongs to
     char usage;
     unsigned int addr =0;  // Block size * block ID for this block
     NodeRelation source;
@@ -99,22 +96,18 @@ class RelationBlock {
     RelationBlock *nextDestination();
     RelationBlock *previousDestination();
 
-    RelationBlock *add(NodeBlock, NodeBlock);
-    static RelationBlock *get(unsigned int);
+    static RelationBlock *add(NodeBlock, NodeBlock);
+    static RelationBlock *get(StoreHandles *, unsigned int);
     void addProperty(std::string, char *);
     PropertyEdgeLink *getPropertyHead();
     std::map<std::string, char *> getAllProperties();
 
-    static unsigned int nextRelationIndex;
-    static unsigned int nextCentralRelationIndex;
     static const unsigned long BLOCK_SIZE;  // Size of a relation record block in bytes
     static std::string DB_PATH;
-    static std::fstream *relationsDB;
-    static std::fstream *centralrelationsDB;
     static const int RECORD_SIZE = sizeof(unsigned int);
 
     static RelationBlock *addCentral(NodeBlock source, NodeBlock destination);
-    static RelationBlock *getCentral(unsigned int address);
+    static RelationBlock *getCentral(StoreHandles *store, unsigned int address);
 
     void addCentralProperty(std::string name, char *value);
 
@@ -0,0 +1,53 @@
+/**
+Copyright 2023 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+**/
+
+#include <pthread.h>
+
+#include <atomic>
+
+#include "BlockCache.h"
+#include "MmapBlockFile.h"
+
+#ifndef STORE_HANDLES
+#define STORE_HANDLES
+
+/**
+ * Database files and allocation cursors of one graph partition's native store.
+ *
+ * Owned by the NodeManager of that partition. Every NodeBlock, RelationBlock, PropertyLink and PropertyEdgeLink
+ * keeps a pointer to the handles of the store it was read from, so several partitions can be open in the same
+ * worker process at once.
+ **/
+struct StoreHandles {
+    MmapBlockFile *nodesDB = NULL;
+    MmapBlockFile *relationsDB = NULL;
+    MmapBlockFile *centralRelationsDB = NULL;
+    MmapBlockFile *propertiesDB = NULL;
+    MmapBlockFile *edgePropertiesDB = NULL;
+
+    // Node and relation blocks are always read and written through these caches, never through the files directly
+    BlockCache *nodesCache = NULL;
+    BlockCache *relationsCache = NULL;
+    BlockCache *centralRelationsCache = NULL;
+
+    // Next free block indexes. Starting with 1 because of the 0 and '\0' differentiation issue
+    // Relation slots are claimed with a single atomic increment so concurrent edge inserts never share a block
+    std::atomic<unsigned int> nextRelationIndex{1};
+    std::atomic<unsigned int> nextCentralRelationIndex{1};
+    unsigned int nextPropertyIndex = 1;
+    unsigned int nextEdgePropertyIndex = 1;
+
+    pthread_mutex_t propertyLock;  // Guards property block allocation and property list splicing
+};
+
+#endif
@@ -0,0 +1,90 @@
+/**
+Copyright 2023 JasmineGraph Team
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+    http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+**/
+
+/**
+ * Multi threaded ingest benchmark for the native store.
+ *
+ * Streams the same random edge list into a fresh NodeManager with 1, 2, 4 ... up to the given number of threads
+ * and prints the edge insert throughput of each run. Store files are created in the instance data folder
+ * configured in jasminegraph-server.properties.
+ *
+ * Usage: NativeStoreIngestBenchmark [vertices] [edges] [max threads]
+ **/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../src/nativestore/NodeManager.h"
+#include "../../src/nativestore/RelationBlock.h"
+
+static double ingest(unsigned int graphID, const std::vector<std::pair<std::string, std::string>> &edges,
+                     unsigned int threadCount) {
+    GraphConfig gc;
+    gc.graphID = graphID;
+    gc.partitionID = 0;
+    gc.maxLabelSize = 43;
+    gc.openMode = "trunc";
+    NodeManager *nodeManager = new NodeManager(gc);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned int t = 0; t < threadCount; t++) {
+        workers.push_back(std::thread([&, t]() {
+            for (size_t i = t; i < edges.size(); i += threadCount) {
+                nodeManager->addEdge(edges[i]);
+            }
+        }));
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    nodeManager->close();
+    delete nodeManager;
+    return seconds;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned int vertexCount = argc > 1 ? std::stoul(argv[1]) : 100000;
+    unsigned int edgeCount = argc > 2 ? std::stoul(argv[2]) : 1000000;
+    unsigned int maxThreads = argc > 3 ? std::stoul(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::mt19937 random(42);
+    std::vector<std::pair<std::string, std::string>> edges;
+    edges.reserve(edgeCount);
+    while (edges.size() < edgeCount) {
+        unsigned int source = random() % vertexCount;
+        unsigned int destination = random() % vertexCount;
+        if (source != destination) {
+            edges.push_back({std::to_string(source), std::to_string(destination)});
+        }
+    }
+
+    double baseline = 0;
+    for (unsigned int threads = 1; threads <= maxThreads; threads *= 2) {
+        double seconds = ingest(900000 + threads, edges, threads);
+        if (threads == 1) {
+            baseline = seconds;
+        }
+        std::cout << threads << " threads: " << seconds << " s, " << (unsigned long)(edgeCount / seconds)
+                  << " edges/s, speedup " << baseline / seconds << std::endl;
+    }
+    return 0;
+}